@@ -0,0 +1,306 @@
+#include "JsonBase64.h"
+
+#ifndef JSON_UTILS_BASE64_SSSE3
+#if defined(__SSSE3__) || defined(__AVX__)
+#define JSON_UTILS_BASE64_SSSE3 1
+#else
+#define JSON_UTILS_BASE64_SSSE3 0
+#endif
+#endif
+
+#if JSON_UTILS_BASE64_SSSE3
+#include <tmmintrin.h>
+#endif
+
+namespace Json
+{
+namespace Base64
+{
+namespace
+{
+constexpr ANSICHAR Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/** Maps a character to its 6-bit value, or to 0xff when it is not part of the alphabet. */
+struct FDecodeTable
+{
+	uint8 Values[256];
+
+	FDecodeTable()
+	{
+		FMemory::Memset(Values, 0xff, sizeof(Values));
+		for (uint8 index = 0; index < 64; ++index)
+		{
+			Values[static_cast<uint8>(Alphabet[index])] = index;
+		}
+	}
+};
+
+const FDecodeTable DecodeTable;
+
+template <typename CharacterType>
+void EncodeScalar(const uint8* bytes, SIZE_T count, CharacterType* output)
+{
+	for (; count >= 3; count -= 3, bytes += 3, output += 4)
+	{
+		const uint32 triple = (bytes[0] << 16) | (bytes[1] << 8) | bytes[2];
+		output[0] = Alphabet[(triple >> 18) & 0x3f];
+		output[1] = Alphabet[(triple >> 12) & 0x3f];
+		output[2] = Alphabet[(triple >> 6) & 0x3f];
+		output[3] = Alphabet[triple & 0x3f];
+	}
+
+	if (count > 0)
+	{
+		const uint32 triple = (bytes[0] << 16) | (count > 1 ? bytes[1] << 8 : 0);
+		output[0] = Alphabet[(triple >> 18) & 0x3f];
+		output[1] = Alphabet[(triple >> 12) & 0x3f];
+		output[2] = count > 1 ? Alphabet[(triple >> 6) & 0x3f] : '=';
+		output[3] = '=';
+	}
+}
+
+template <typename CharacterType>
+uint8 DecodeCharacter(const CharacterType character)
+{
+	return static_cast<uint32>(character) < 256 ? DecodeTable.Values[static_cast<uint32>(character)]
+												: 0xff;
+}
+
+/** Decodes complete, unpadded groups of four characters. */
+template <typename CharacterType>
+bool DecodeScalar(const CharacterType* text, SIZE_T length, uint8* output)
+{
+	for (; length >= 4; length -= 4, text += 4, output += 3)
+	{
+		const uint8 a = DecodeCharacter(text[0]);
+		const uint8 b = DecodeCharacter(text[1]);
+		const uint8 c = DecodeCharacter(text[2]);
+		const uint8 d = DecodeCharacter(text[3]);
+		if ((a | b | c | d) & 0xc0)
+		{
+			return false;
+		}
+
+		const uint32 triple = (a << 18) | (b << 12) | (c << 6) | d;
+		output[0] = static_cast<uint8>(triple >> 16);
+		output[1] = static_cast<uint8>(triple >> 8);
+		output[2] = static_cast<uint8>(triple);
+	}
+
+	return true;
+}
+
+/** Decodes the last group, which may have been shortened by padding. */
+template <typename CharacterType>
+bool DecodeTail(const CharacterType* text, const SIZE_T length, uint8* output)
+{
+	if (length < 2)
+	{
+		return length == 0;
+	}
+
+	const uint8 a = DecodeCharacter(text[0]);
+	const uint8 b = DecodeCharacter(text[1]);
+	const uint8 c = length > 2 ? DecodeCharacter(text[2]) : 0;
+	if ((a | b | c) & 0xc0)
+	{
+		return false;
+	}
+
+	output[0] = static_cast<uint8>((a << 2) | (b >> 4));
+	if (length > 2)
+	{
+		output[1] = static_cast<uint8>((b << 4) | (c >> 2));
+	}
+
+	return true;
+}
+
+template <typename CharacterType>
+SIZE_T UnpaddedLength(const CharacterType* text, SIZE_T length)
+{
+	if (length % 4 == 0)
+	{
+		for (int32 padding = 0; padding < 2 && length > 0 && text[length - 1] == '='; ++padding)
+		{
+			--length;
+		}
+	}
+
+	return length;
+}
+
+#if JSON_UTILS_BASE64_SSSE3
+// Vector codecs after Wojciech Muła's SSSE3 base64 encoder and decoder: twelve bytes become
+// sixteen characters per step and back.
+
+FORCEINLINE __m128i EncodeLookup(const __m128i indices)
+{
+	const __m128i shift_table = _mm_setr_epi8(
+		'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+	// 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12.
+	__m128i selector = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+	const __m128i is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+	selector = _mm_or_si128(selector, _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+
+	return _mm_add_epi8(_mm_shuffle_epi8(shift_table, selector), indices);
+}
+
+SIZE_T EncodeVector(const uint8* bytes, const SIZE_T count, ANSICHAR* output)
+{
+	SIZE_T consumed = 0;
+
+	// Each step reads sixteen bytes but only encodes twelve of them.
+	for (; consumed + 16 <= count; consumed += 12, output += 16)
+	{
+		__m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + consumed));
+		input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+		const __m128i high = _mm_mulhi_epu16(
+			_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+		const __m128i low = _mm_mullo_epi16(
+			_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output), EncodeLookup(_mm_or_si128(high, low)));
+	}
+
+	return consumed;
+}
+
+SIZE_T DecodeVector(const ANSICHAR* text, const SIZE_T length, uint8* output)
+{
+	SIZE_T consumed = 0;
+
+	for (; consumed + 16 <= length; consumed += 16, output += 12)
+	{
+		const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + consumed));
+
+		const auto in_range = [&input](ANSICHAR first, ANSICHAR last) {
+			return _mm_and_si128(
+				_mm_cmpgt_epi8(input, _mm_set1_epi8(first - 1)),
+				_mm_cmplt_epi8(input, _mm_set1_epi8(last + 1)));
+		};
+
+		const __m128i upper = in_range('A', 'Z');
+		const __m128i lower = in_range('a', 'z');
+		const __m128i digit = in_range('0', '9');
+		const __m128i plus = _mm_cmpeq_epi8(input, _mm_set1_epi8('+'));
+		const __m128i slash = _mm_cmpeq_epi8(input, _mm_set1_epi8('/'));
+
+		const __m128i valid = _mm_or_si128(
+			_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+		if (_mm_movemask_epi8(valid) != 0xffff)
+		{
+			// Leave the rest, including the invalid character, to the scalar decoder.
+			break;
+		}
+
+		__m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+		shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+		shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+		shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+		shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+		const __m128i values = _mm_add_epi8(input, shift);
+
+		// Merge pairs of 6-bit values into 12 bits, then pairs of those into 24 bits per lane.
+		const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+		const __m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+		const __m128i packed = _mm_shuffle_epi8(
+			triples, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+		alignas(16) uint8 block[16];
+		_mm_store_si128(reinterpret_cast<__m128i*>(block), packed);
+		FMemory::Memcpy(output, block, 12);
+	}
+
+	return consumed;
+}
+#else
+SIZE_T EncodeVector(const uint8*, SIZE_T, ANSICHAR*)
+{
+	return 0;
+}
+
+SIZE_T DecodeVector(const ANSICHAR*, SIZE_T, uint8*)
+{
+	return 0;
+}
+#endif
+
+SIZE_T EncodeVector(const uint8*, SIZE_T, TCHAR*)
+{
+	return 0;
+}
+
+SIZE_T DecodeVector(const TCHAR*, SIZE_T, uint8*)
+{
+	return 0;
+}
+
+template <typename CharacterType>
+void EncodeImpl(const uint8* const bytes, const SIZE_T count, CharacterType* const output)
+{
+	const SIZE_T consumed = EncodeVector(bytes, count, output);
+	EncodeScalar(bytes + consumed, count - consumed, output + consumed / 3 * 4);
+}
+
+template <typename CharacterType>
+bool DecodeImpl(const CharacterType* const text, SIZE_T length, uint8* const output)
+{
+	length = UnpaddedLength(text, length);
+
+	const SIZE_T consumed = DecodeVector(text, length, output);
+	const SIZE_T whole_groups = (length - consumed) / 4 * 4;
+	uint8* const scalar_output = output + consumed / 4 * 3;
+
+	return DecodeScalar(text + consumed, whole_groups, scalar_output) &&
+		DecodeTail(text + consumed + whole_groups, length - consumed - whole_groups,
+				   scalar_output + whole_groups / 4 * 3);
+}
+
+template <typename CharacterType>
+SIZE_T DecodedSizeImpl(const CharacterType* const text, const SIZE_T length)
+{
+	const SIZE_T unpadded = UnpaddedLength(text, length);
+	return unpadded / 4 * 3 + (unpadded % 4 == 0 ? 0 : unpadded % 4 - 1);
+}
+} // namespace
+
+SIZE_T EncodedLength(const SIZE_T byte_count)
+{
+	return (byte_count + 2) / 3 * 4;
+}
+
+void Encode(const uint8* const bytes, const SIZE_T count, ANSICHAR* const output)
+{
+	EncodeImpl(bytes, count, output);
+}
+
+void Encode(const uint8* const bytes, const SIZE_T count, TCHAR* const output)
+{
+	EncodeImpl(bytes, count, output);
+}
+
+SIZE_T DecodedSize(const ANSICHAR* const text, const SIZE_T length)
+{
+	return DecodedSizeImpl(text, length);
+}
+
+SIZE_T DecodedSize(const TCHAR* const text, const SIZE_T length)
+{
+	return DecodedSizeImpl(text, length);
+}
+
+bool Decode(const ANSICHAR* const text, const SIZE_T length, uint8* const output)
+{
+	return DecodeImpl(text, length, output);
+}
+
+bool Decode(const TCHAR* const text, const SIZE_T length, uint8* const output)
+{
+	return DecodeImpl(text, length, output);
+}
+} // namespace Base64
+} // namespace Json
@@ -0,0 +1,178 @@
+#include "JsonBenchmarkCorpus.h"
+
+#include "Math/RandomStream.h"
+
+namespace Json
+{
+namespace Benchmark
+{
+namespace
+{
+constexpr int32 Seed = 20160203;
+
+/** A few words need escaping or are outside ASCII, as in real tweets. */
+const TCHAR* const Words[] = {
+	TEXT("the"), TEXT("json"), TEXT("unreal"), TEXT("release"), TEXT("today"), TEXT("build"),
+	TEXT("fast"), TEXT("parser"), TEXT("#gamedev"), TEXT("@epic"), TEXT("https://t.co/x"),
+	TEXT("\"quoted\""), TEXT("line\nbreak"), TEXT("tab\tbed"), TEXT("caf\u00E9"), TEXT("na\u00EFve"),
+	TEXT("\u3053\u3093\u306B\u3061\u306F"), TEXT("\u4E16\u754C"), TEXT("\U0001F680"),
+};
+
+FString MakeSentence(FRandomStream& random, const int32 word_count)
+{
+	FString sentence;
+	for (int32 index = 0; index < word_count; ++index)
+	{
+		if (index > 0)
+		{
+			sentence.AppendChar(TEXT(' '));
+		}
+		sentence.Append(Words[random.RandHelper(UE_ARRAY_COUNT(Words))]);
+	}
+
+	return sentence;
+}
+
+FString MakeIdentifier(FRandomStream& random, const int32 length)
+{
+	FString identifier;
+	for (int32 index = 0; index < length; ++index)
+	{
+		identifier.AppendChar(static_cast<TCHAR>(TEXT('a') + random.RandHelper(26)));
+	}
+
+	return identifier;
+}
+} // namespace
+
+FTimeline MakeTimeline(const int32 scale)
+{
+	FRandomStream random{ Seed };
+
+	FTimeline timeline;
+	const int32 status_count = 80 * scale;
+	timeline.Statuses.Reserve(status_count);
+	for (int32 index = 0; index < status_count; ++index)
+	{
+		FStatus& status = timeline.Statuses.AddDefaulted_GetRef();
+		status.Id = 505874924095815681ll + index * 7919ll;
+		status.CreatedAt = FString::Printf(
+			TEXT("Sun Aug 31 %02d:%02d:%02d +0000 2014"), random.RandHelper(24), random.RandHelper(60),
+			random.RandHelper(60));
+		status.Text = MakeSentence(random, 6 + random.RandHelper(14));
+
+		FUser& user = status.User;
+		user.Id = 1186275104ll + random.RandHelper(1000000);
+		user.Name = MakeSentence(random, 2);
+		user.ScreenName = MakeIdentifier(random, 6 + random.RandHelper(8));
+		user.Location = random.RandHelper(3) == 0 ? FString() : MakeSentence(random, 2);
+		user.Description = MakeSentence(random, random.RandHelper(20));
+		user.FollowersCount = random.RandHelper(100000);
+		user.FriendsCount = random.RandHelper(5000);
+		user.Verified = random.RandHelper(10) == 0;
+
+		const int32 hashtag_count = random.RandHelper(4);
+		for (int32 hashtag_index = 0; hashtag_index < hashtag_count; ++hashtag_index)
+		{
+			FHashtag& hashtag = status.Hashtags.AddDefaulted_GetRef();
+			hashtag.Text = MakeIdentifier(random, 4 + random.RandHelper(10));
+			const int32 start = random.RandHelper(100);
+			hashtag.Indices = { start, start + hashtag.Text.Len() + 1 };
+		}
+
+		status.RetweetCount = random.RandHelper(500);
+		status.FavoriteCount = random.RandHelper(500);
+		status.Favorited = random.RandHelper(2) == 0;
+		if (random.RandHelper(4) == 0)
+		{
+			status.InReplyToStatusId = status.Id - random.RandHelper(100000);
+		}
+		status.Lang = random.RandHelper(2) == 0 ? TEXT("ja") : TEXT("en");
+	}
+
+	return timeline;
+}
+
+FFeatureCollection MakeFeatureCollection(const int32 scale)
+{
+	FRandomStream random{ Seed };
+
+	FFeatureCollection collection;
+	collection.Type = TEXT("FeatureCollection");
+
+	FFeature& feature = collection.Features.AddDefaulted_GetRef();
+	feature.Type = TEXT("Feature");
+	feature.Properties.Add(TEXT("name"), TEXT("Canada"));
+	feature.Geometry.Type = TEXT("Polygon");
+
+	// Rings walk along a coastline in small steps, so coordinates keep all their digits.
+	const int32 ring_count = 5 * scale;
+	for (int32 ring_index = 0; ring_index < ring_count; ++ring_index)
+	{
+		TArray<TArray<double>>& ring = feature.Geometry.Coordinates.AddDefaulted_GetRef();
+		double longitude = -65.613616999999977 - ring_index;
+		double latitude = 43.420273000000009 + ring_index * 0.5;
+
+		constexpr int32 PointCount = 250;
+		ring.Reserve(PointCount);
+		for (int32 point_index = 0; point_index < PointCount; ++point_index)
+		{
+			longitude += random.FRandRange(-0.01f, 0.01f) * 1.0000000000001;
+			latitude += random.FRandRange(-0.01f, 0.01f) * 1.0000000000001;
+			ring.Add({ longitude, latitude });
+		}
+	}
+
+	return collection;
+}
+
+FCatalog MakeCatalog(const int32 scale)
+{
+	FRandomStream random{ Seed };
+
+	FCatalog catalog;
+	for (int32 index = 0; index < 10; ++index)
+	{
+		catalog.AreaNames.Add(205705993 + index, MakeIdentifier(random, 12));
+		catalog.SeatCategoryNames.Add(338937235 + index, MakeIdentifier(random, 8));
+	}
+
+	const int32 event_count = 30 * scale;
+	for (int32 index = 0; index < event_count; ++index)
+	{
+		FEvent& event = catalog.Events.Add(138586341 + index);
+		event.Id = 138586341 + index;
+		event.Name = MakeSentence(random, 3);
+		event.SubTopicIds = { 337184269, 337184283 + random.RandHelper(20) };
+		event.TopicIds = { 107888604, 324846099 + random.RandHelper(20) };
+	}
+
+	const int32 performance_count = 120 * scale;
+	catalog.Performances.Reserve(performance_count);
+	for (int32 index = 0; index < performance_count; ++index)
+	{
+		FPerformance& performance = catalog.Performances.AddDefaulted_GetRef();
+		performance.Id = 339887544 + index;
+		performance.EventId = 138586341 + random.RandHelper(event_count);
+		if (random.RandHelper(5) == 0)
+		{
+			performance.Name = MakeSentence(random, 2);
+		}
+
+		const int32 price_count = 1 + random.RandHelper(4);
+		for (int32 price_index = 0; price_index < price_count; ++price_index)
+		{
+			FPrice& price = performance.Prices.AddDefaulted_GetRef();
+			price.Amount = 9000 + random.RandHelper(200) * 500;
+			price.AudienceSubCategoryId = 337100890;
+			price.SeatCategoryId = 338937235 + random.RandHelper(10);
+		}
+
+		performance.Start = 1372701600000ll + index * 86400000ll;
+		performance.VenueCode = TEXT("PLEYEL_PLEYEL");
+	}
+
+	return catalog;
+}
+} // namespace Benchmark
+} // namespace Json
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+namespace Benchmark
+{
+/**
+ * Typed workloads shaped after the corpora JSON libraries are usually measured on. They are
+ * generated rather than shipped, from a fixed seed, so every run measures the same documents.
+ **/
+
+/** twitter.json: short records with many strings, some of them escaped or non-ASCII. */
+struct FUser
+{
+	int64 Id = 0;
+	FString Name;
+	FString ScreenName;
+	FString Location;
+	FString Description;
+	int32 FollowersCount = 0;
+	int32 FriendsCount = 0;
+	bool Verified = false;
+
+	JSON_DEFINE(Id, Name, ScreenName, Location, Description, FollowersCount, FriendsCount, Verified)
+};
+
+struct FHashtag
+{
+	FString Text;
+	TArray<int32> Indices;
+
+	JSON_DEFINE(Text, Indices)
+};
+
+struct FStatus
+{
+	int64 Id = 0;
+	FString CreatedAt;
+	FString Text;
+	FUser User;
+	TArray<FHashtag> Hashtags;
+	int32 RetweetCount = 0;
+	int32 FavoriteCount = 0;
+	bool Favorited = false;
+	TOptional<int64> InReplyToStatusId;
+	FString Lang;
+
+	JSON_DEFINE(
+		Id, CreatedAt, Text, User, Hashtags, RetweetCount, FavoriteCount, Favorited, InReplyToStatusId,
+		Lang)
+};
+
+struct FTimeline
+{
+	TArray<FStatus> Statuses;
+
+	JSON_DEFINE(Statuses)
+};
+
+/** canada.json: GeoJSON polygons, nearly all of it doubles with full precision. */
+struct FGeometry
+{
+	FString Type;
+	TArray<TArray<TArray<double>>> Coordinates;
+
+	JSON_DEFINE(Type, Coordinates)
+};
+
+struct FFeature
+{
+	FString Type;
+	TMap<FString, FString> Properties;
+	FGeometry Geometry;
+
+	JSON_DEFINE(Type, Properties, Geometry)
+};
+
+struct FFeatureCollection
+{
+	FString Type;
+	TArray<FFeature> Features;
+
+	JSON_DEFINE(Type, Features)
+};
+
+/** citm_catalog.json: integer-keyed maps and arrays of small integers. */
+struct FPrice
+{
+	int32 Amount = 0;
+	int32 AudienceSubCategoryId = 0;
+	int32 SeatCategoryId = 0;
+
+	JSON_DEFINE(Amount, AudienceSubCategoryId, SeatCategoryId)
+};
+
+struct FPerformance
+{
+	int64 Id = 0;
+	int64 EventId = 0;
+	TOptional<FString> Name;
+	TArray<FPrice> Prices;
+	int64 Start = 0;
+	FString VenueCode;
+
+	JSON_DEFINE(Id, EventId, Name, Prices, Start, VenueCode)
+};
+
+struct FEvent
+{
+	int64 Id = 0;
+	FString Name;
+	TArray<int32> SubTopicIds;
+	TArray<int32> TopicIds;
+
+	JSON_DEFINE(Id, Name, SubTopicIds, TopicIds)
+};
+
+struct FCatalog
+{
+	TMap<int32, FString> AreaNames;
+	TMap<int32, FEvent> Events;
+	TArray<FPerformance> Performances;
+	TMap<int32, FString> SeatCategoryNames;
+
+	JSON_DEFINE(AreaNames, Events, Performances, SeatCategoryNames)
+};
+
+/** Each scale step adds about 50 KB of compact JSON; `scale` 10 is close to the original files. */
+FTimeline MakeTimeline(int32 scale);
+FFeatureCollection MakeFeatureCollection(int32 scale);
+FCatalog MakeCatalog(int32 scale);
+} // namespace Benchmark
+} // namespace Json
@@ -0,0 +1,166 @@
+#include "JsonCompressed.h"
+
+#include "zlib.h"
+
+namespace Json
+{
+namespace
+{
+/** zlib's window size; adding 16 selects gzip framing and adding 32 detects either on input. */
+constexpr int WindowBits = 15;
+constexpr int MemoryLevel = 8;
+} // namespace
+
+FDeflateOutputStream::FDeflateOutputStream(
+	FArchive& archive, const EJsonCompression format, const int32 level)
+	: Archive(archive)
+	, Stream(MakeUnique<z_stream_s>())
+{
+	Text.SetNumUninitialized(ChunkSize);
+	Compressed.SetNumUninitialized(ChunkSize);
+	Cursor = Text.GetData();
+	TextEnd = Text.GetData() + ChunkSize;
+
+	FMemory::Memzero(Stream.Get(), sizeof(z_stream_s));
+	const int window_bits = format == EJsonCompression::Gzip ? WindowBits + 16 : WindowBits;
+	if (deflateInit2(Stream.Get(), level, Z_DEFLATED, window_bits, MemoryLevel, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Could not initialize the deflate stream."));
+		Failed = true;
+		Finished = true;
+	}
+}
+
+FDeflateOutputStream::~FDeflateOutputStream()
+{
+	if (!Finished)
+	{
+		Finish();
+	}
+}
+
+bool FDeflateOutputStream::Finish()
+{
+	if (!Finished)
+	{
+		Deflate(true);
+		deflateEnd(Stream.Get());
+		Finished = true;
+	}
+
+	return !Failed && !Archive.IsError();
+}
+
+void FDeflateOutputStream::Deflate(const bool finish)
+{
+	Written += Cursor - Text.GetData();
+
+	if (Finished || Failed)
+	{
+		// Keep accepting characters after a failure; they are simply dropped.
+		Cursor = Text.GetData();
+		return;
+	}
+
+	Stream->next_in = reinterpret_cast<Bytef*>(Text.GetData());
+	Stream->avail_in = static_cast<uInt>(Cursor - Text.GetData());
+
+	int result;
+	do
+	{
+		Stream->next_out = Compressed.GetData();
+		Stream->avail_out = ChunkSize;
+
+		result = deflate(Stream.Get(), finish ? Z_FINISH : Z_NO_FLUSH);
+		if (result == Z_STREAM_ERROR)
+		{
+			UE_LOG(LogRapidJson, Error, TEXT("Could not deflate JSON text."));
+			Failed = true;
+			break;
+		}
+
+		const int64 produced = ChunkSize - Stream->avail_out;
+		if (produced > 0)
+		{
+			Archive.Serialize(Compressed.GetData(), produced);
+		}
+	} while (Stream->avail_out == 0 || (finish && result != Z_STREAM_END));
+
+	Cursor = Text.GetData();
+}
+
+FInflateInputStream::FInflateInputStream(FArchive& archive)
+	: Archive(archive)
+	, Stream(MakeUnique<z_stream_s>())
+{
+	Compressed.SetNumUninitialized(ChunkSize);
+	Text.SetNumUninitialized(ChunkSize);
+
+	FMemory::Memzero(Stream.Get(), sizeof(z_stream_s));
+	if (inflateInit2(Stream.Get(), WindowBits + 32) != Z_OK)
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Could not initialize the inflate stream."));
+		Failed = Drained = true;
+	}
+
+	Inflate();
+}
+
+FInflateInputStream::~FInflateInputStream()
+{
+	inflateEnd(Stream.Get());
+}
+
+void FInflateInputStream::Inflate()
+{
+	Ch* const text = Text.GetData();
+	Current = text;
+
+	Stream->next_out = reinterpret_cast<Bytef*>(text);
+	Stream->avail_out = ChunkSize;
+
+	while (!Drained && Stream->avail_out == ChunkSize)
+	{
+		if (Stream->avail_in == 0)
+		{
+			const int64 remaining = Archive.TotalSize() - Archive.Tell();
+			const int32 read_size = static_cast<int32>(FMath::Min<int64>(remaining, ChunkSize));
+			if (read_size <= 0 || Archive.IsError())
+			{
+				UE_LOG(LogRapidJson, Error, TEXT("Compressed JSON ended before the end of the stream."));
+				Failed = Drained = true;
+				break;
+			}
+
+			Archive.Serialize(Compressed.GetData(), read_size);
+			Stream->next_in = Compressed.GetData();
+			Stream->avail_in = static_cast<uInt>(read_size);
+		}
+
+		const int result = inflate(Stream.Get(), Z_NO_FLUSH);
+		if (result == Z_STREAM_END)
+		{
+			Drained = true;
+		}
+		else if (result != Z_OK && result != Z_BUF_ERROR)
+		{
+			UE_LOG(
+				LogRapidJson, Error, TEXT("Could not inflate JSON text: %s"),
+				UTF8_TO_TCHAR(Stream->msg != nullptr ? Stream->msg : "unknown error"));
+			Failed = Drained = true;
+		}
+	}
+
+	const int32 produced = ChunkSize - static_cast<int32>(Stream->avail_out);
+	if (produced == 0)
+	{
+		// Present the terminating zero rapidjson expects at the end of the text.
+		text[0] = '\0';
+		TextEnd = text + 1;
+		Ended = true;
+		return;
+	}
+
+	TextEnd = text + produced;
+}
+} // namespace Json
@@ -0,0 +1,179 @@
+#include "JsonFileStream.h"
+
+#include "HAL/FileManager.h"
+
+namespace Json
+{
+FAsyncFileOutputStream::FAsyncFileOutputStream(const TCHAR* const path, const int32 buffer_size)
+	: Archive(IFileManager::Get().CreateFileWriter(path))
+{
+	if (!Archive.IsValid())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Could not open %s for writing."), path);
+		Failed = true;
+	}
+
+	for (TArray<Ch>& buffer : Buffers)
+	{
+		buffer.SetNumUninitialized(FMath::Max(buffer_size, 1));
+	}
+
+	Cursor = Buffers[ActiveBuffer].GetData();
+	BufferEnd = Cursor + Buffers[ActiveBuffer].Num();
+}
+
+FAsyncFileOutputStream::~FAsyncFileOutputStream()
+{
+	Close();
+}
+
+bool FAsyncFileOutputStream::Close()
+{
+	if (Archive.IsValid())
+	{
+		Submit();
+		WaitForWrite();
+
+		if (!Archive->Close())
+		{
+			Failed = true;
+		}
+		Archive.Reset();
+	}
+
+	return !Failed;
+}
+
+void FAsyncFileOutputStream::Submit()
+{
+	Ch* const buffer = Buffers[ActiveBuffer].GetData();
+	const int64 size = Cursor - buffer;
+	Written += size;
+
+	// The other buffer becomes active only once the disk is done with it.
+	WaitForWrite();
+
+	if (size > 0 && Archive.IsValid() && !Failed)
+	{
+		FArchive* const archive = Archive.Get();
+		PendingWrite = Async(EAsyncExecution::ThreadPool, [archive, buffer, size]() {
+			archive->Serialize(buffer, size);
+			return !archive->IsError();
+		});
+	}
+
+	ActiveBuffer ^= 1;
+	Cursor = Buffers[ActiveBuffer].GetData();
+	BufferEnd = Cursor + Buffers[ActiveBuffer].Num();
+}
+
+void FAsyncFileOutputStream::WaitForWrite()
+{
+	if (PendingWrite.IsValid())
+	{
+		if (!PendingWrite.Get())
+		{
+			UE_LOG(LogRapidJson, Error, TEXT("Could not write JSON text to disk."));
+			Failed = true;
+		}
+		PendingWrite = TFuture<bool>();
+	}
+}
+
+FReadAheadFileInputStream::FReadAheadFileInputStream(
+	const TCHAR* const path, const int32 buffer_size, const int32 buffer_count)
+	: Archive(IFileManager::Get().CreateFileReader(path))
+{
+	if (!Archive.IsValid())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Could not open %s for reading."), path);
+		Failed = true;
+		UseBuffer(INDEX_NONE);
+		return;
+	}
+
+	FileSize = Archive->TotalSize();
+
+	Buffers.SetNum(FMath::Max(buffer_count, 2));
+	for (int32 index = 0; index < Buffers.Num(); ++index)
+	{
+		Buffers[index].Text.SetNumUninitialized(FMath::Max(buffer_size, 1));
+		RequestRead(index);
+	}
+
+	UseBuffer(ActiveBuffer);
+}
+
+FReadAheadFileInputStream::~FReadAheadFileInputStream()
+{
+	// Reads in flight still write into the buffers and use the archive.
+	for (FBuffer& buffer : Buffers)
+	{
+		if (buffer.Read.IsValid())
+		{
+			buffer.Read.Wait();
+		}
+	}
+}
+
+void FReadAheadFileInputStream::RequestRead(const int32 index)
+{
+	FBuffer& buffer = Buffers[index];
+	const int64 offset = NextReadOffset;
+	const int32 size = static_cast<int32>(FMath::Min<int64>(buffer.Text.Num(), FileSize - offset));
+	if (size <= 0)
+	{
+		buffer.Read = TFuture<int32>();
+		return;
+	}
+
+	NextReadOffset += size;
+
+	Ch* const text = buffer.Text.GetData();
+	buffer.Read = Async(EAsyncExecution::ThreadPool, [this, text, offset, size]() {
+		FScopeLock lock(&ArchiveMutex);
+		Archive->Seek(offset);
+		Archive->Serialize(text, size);
+		return Archive->IsError() ? -1 : size;
+	});
+}
+
+void FReadAheadFileInputStream::NextBuffer()
+{
+	Consumed += BufferEnd - BufferBegin;
+
+	RequestRead(ActiveBuffer);
+	ActiveBuffer = (ActiveBuffer + 1) % Buffers.Num();
+	UseBuffer(ActiveBuffer);
+}
+
+void FReadAheadFileInputStream::UseBuffer(const int32 index)
+{
+	static const Ch Terminator = '\0';
+
+	int32 size = 0;
+	if (Buffers.IsValidIndex(index) && Buffers[index].Read.IsValid())
+	{
+		size = Buffers[index].Read.Get();
+		Buffers[index].Read = TFuture<int32>();
+	}
+
+	if (size <= 0)
+	{
+		if (size < 0)
+		{
+			UE_LOG(LogRapidJson, Error, TEXT("Could not read JSON text from disk."));
+			Failed = true;
+		}
+
+		// Present the terminating zero rapidjson expects at the end of the text.
+		BufferBegin = Current = &Terminator;
+		BufferEnd = &Terminator + 1;
+		Ended = true;
+		return;
+	}
+
+	BufferBegin = Current = Buffers[index].Text.GetData();
+	BufferEnd = BufferBegin + size;
+}
+} // namespace Json
@@ -0,0 +1,190 @@
+#include "JsonMessagePack.h"
+
+namespace Json
+{
+bool FMessagePackWriter::Int64(const int64 value)
+{
+	if (value >= 0)
+	{
+		return Uint64(static_cast<uint64>(value));
+	}
+
+	BeginValue();
+
+	if (value >= -32)
+	{
+		Output.Add(static_cast<uint8>(value));
+	}
+	else if (value >= MIN_int8)
+	{
+		Output.Add(0xd0);
+		PutBigEndian(static_cast<uint64>(value), 1);
+	}
+	else if (value >= MIN_int16)
+	{
+		Output.Add(0xd1);
+		PutBigEndian(static_cast<uint64>(value), 2);
+	}
+	else if (value >= MIN_int32)
+	{
+		Output.Add(0xd2);
+		PutBigEndian(static_cast<uint64>(value), 4);
+	}
+	else
+	{
+		Output.Add(0xd3);
+		PutBigEndian(static_cast<uint64>(value), 8);
+	}
+
+	return true;
+}
+
+bool FMessagePackWriter::Uint64(const uint64 value)
+{
+	BeginValue();
+
+	if (value <= 0x7f)
+	{
+		Output.Add(static_cast<uint8>(value));
+	}
+	else if (value <= MAX_uint8)
+	{
+		Output.Add(0xcc);
+		PutBigEndian(value, 1);
+	}
+	else if (value <= MAX_uint16)
+	{
+		Output.Add(0xcd);
+		PutBigEndian(value, 2);
+	}
+	else if (value <= MAX_uint32)
+	{
+		Output.Add(0xce);
+		PutBigEndian(value, 4);
+	}
+	else
+	{
+		Output.Add(0xcf);
+		PutBigEndian(value, 8);
+	}
+
+	return true;
+}
+
+bool FMessagePackWriter::Double(const double value)
+{
+	BeginValue();
+
+	// Narrowing a finite double outside the range of float is undefined, so check first.
+	const bool fits_float =
+		!FMath::IsFinite(value) || FMath::Abs(value) <= static_cast<double>(FLT_MAX);
+	const float narrowed = fits_float ? static_cast<float>(value) : 0.0f;
+	if (fits_float && static_cast<double>(narrowed) == value)
+	{
+		uint32 bits;
+		FMemory::Memcpy(&bits, &narrowed, sizeof(bits));
+		Output.Add(0xca);
+		PutBigEndian(bits, 4);
+	}
+	else
+	{
+		uint64 bits;
+		FMemory::Memcpy(&bits, &value, sizeof(bits));
+		Output.Add(0xcb);
+		PutBigEndian(bits, 8);
+	}
+
+	return true;
+}
+
+bool FMessagePackWriter::String(const Ch* const string, const rapidjson::SizeType length, bool)
+{
+	BeginValue();
+
+	if (length <= 31)
+	{
+		Output.Add(static_cast<uint8>(0xa0 | length));
+	}
+	else if (length <= MAX_uint8)
+	{
+		Output.Add(0xd9);
+		PutBigEndian(length, 1);
+	}
+	else if (length <= MAX_uint16)
+	{
+		Output.Add(0xda);
+		PutBigEndian(length, 2);
+	}
+	else
+	{
+		Output.Add(0xdb);
+		PutBigEndian(length, 4);
+	}
+
+	Output.Append(reinterpret_cast<const uint8*>(string), static_cast<int32>(length));
+	return true;
+}
+
+bool FMessagePackWriter::StartContainer()
+{
+	BeginValue();
+
+	Containers.Add(FContainer{ Output.Num(), 0, false });
+	Output.AddUninitialized(PlaceholderSize);
+	return true;
+}
+
+bool FMessagePackWriter::EndContainer(const uint8 fix_type, const uint8 sized_type)
+{
+	if (Containers.Num() == 0)
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Closing a MessagePack container that was never opened."));
+		return false;
+	}
+
+	const FContainer container = Containers.Pop(false);
+	const bool is_object = fix_type == 0x80;
+	const uint32 count = is_object ? container.Count / 2 : container.Count;
+
+	uint8 header[PlaceholderSize];
+	int32 header_size;
+
+	if (count <= 15)
+	{
+		header[0] = static_cast<uint8>(fix_type | count);
+		header_size = 1;
+	}
+	else if (count <= MAX_uint16)
+	{
+		header[0] = sized_type;
+		header[1] = static_cast<uint8>(count >> 8);
+		header[2] = static_cast<uint8>(count);
+		header_size = 3;
+	}
+	else
+	{
+		header[0] = static_cast<uint8>(sized_type + 1);
+		header[1] = static_cast<uint8>(count >> 24);
+		header[2] = static_cast<uint8>(count >> 16);
+		header[3] = static_cast<uint8>(count >> 8);
+		header[4] = static_cast<uint8>(count);
+		header_size = 5;
+	}
+
+	// Slide the contents back over the unused part of the placeholder.
+	const int32 payload_offset = container.HeaderOffset + PlaceholderSize;
+	const int32 payload_size = Output.Num() - payload_offset;
+	const int32 slack = PlaceholderSize - header_size;
+
+	uint8* const data = Output.GetData();
+	FMemory::Memcpy(data + container.HeaderOffset, header, header_size);
+
+	if (slack > 0)
+	{
+		FMemory::Memmove(data + container.HeaderOffset + header_size, data + payload_offset, payload_size);
+		Output.SetNum(Output.Num() - slack, false);
+	}
+
+	return true;
+}
+} // namespace Json
@@ -0,0 +1,253 @@
+#include "JsonNameCache.h"
+
+#include "Misc/ScopeRWLock.h"
+#include "JsonHash.h"
+
+namespace Json
+{
+namespace
+{
+/** Key and extra bytes per slot: 128 per entry at the quarter load that resets a table. */
+constexpr int32 BytesPerSlot = 32;
+
+/**
+ * Open-addressing table from byte strings to values, with the keys packed in one buffer. Once a
+ * quarter of the slots or the whole buffer is used, the next insertion empties it first, starting
+ * over at twice the size until `max_slot_count` slots.
+ *
+ * @note Tables start small, since most threads only ever see a few names. Growing starts over
+ * rather than rehashing, as moving the buffer would leave values pointing into the old one.
+ **/
+template <typename ValueType> class TByteKeyTable
+{
+public:
+	TByteKeyTable(const int32 initial_slot_count, const int32 max_slot_count)
+		: MaxSlotCount(max_slot_count)
+	{
+		Reset(initial_slot_count);
+	}
+
+	const ValueType* Find(const uint64 hash, const void* const key, const int32 length) const
+	{
+		const int32 mask = Slots.Num() - 1;
+		for (int32 index = static_cast<int32>(hash) & mask;; index = (index + 1) & mask)
+		{
+			const FSlot& slot = Slots[index];
+			if (slot.Length < 0)
+			{
+				return nullptr;
+			}
+
+			if (slot.Hash == hash && slot.Length == length &&
+				FMemory::Memcmp(Bytes.GetData() + slot.Offset, key, length) == 0)
+			{
+				return &slot.Value;
+			}
+		}
+	}
+
+	/**
+	 * Adds a key that is not in the table yet and returns its value. `extra_length` more bytes can
+	 * be stored right after the key; `extra` then points at them.
+	 **/
+	ValueType& Add(
+		const uint64 hash, const void* const key, const int32 length, ANSICHAR** const extra = nullptr,
+		const int32 extra_length = 0)
+	{
+		if ((Count + 1) * 4 > Slots.Num() || Bytes.Num() + length + extra_length > ByteCapacity)
+		{
+			Reset(FMath::Min(Slots.Num() * 2, MaxSlotCount));
+		}
+
+		const int32 mask = Slots.Num() - 1;
+		int32 index = static_cast<int32>(hash) & mask;
+		while (Slots[index].Length >= 0)
+		{
+			index = (index + 1) & mask;
+		}
+
+		FSlot& slot = Slots[index];
+		slot.Hash = hash;
+		slot.Offset = Bytes.Num();
+		slot.Length = length;
+		Bytes.Append(static_cast<const ANSICHAR*>(key), length);
+		++Count;
+
+		if (extra != nullptr)
+		{
+			*extra = Bytes.GetData() + Bytes.Num();
+			Bytes.AddUninitialized(extra_length);
+		}
+
+		return slot.Value;
+	}
+
+private:
+	struct FSlot
+	{
+		uint64 Hash = 0;
+		int32 Offset = 0;
+		/** -1 for an empty slot. */
+		int32 Length = -1;
+		ValueType Value;
+	};
+
+	void Reset(const int32 slot_count)
+	{
+		if (slot_count == Slots.Num())
+		{
+			for (FSlot& slot : Slots)
+			{
+				slot = FSlot{};
+			}
+		}
+		else
+		{
+			Slots.Empty(slot_count);
+			Slots.SetNum(slot_count);
+		}
+
+		// Never grown past this, so stored bytes keep their address until the table is reset.
+		ByteCapacity = slot_count * BytesPerSlot;
+		Bytes.Empty(ByteCapacity);
+		Count = 0;
+	}
+
+	TArray<FSlot> Slots;
+	TArray<ANSICHAR> Bytes;
+	int32 ByteCapacity = 0;
+	int32 MaxSlotCount;
+	int32 Count = 0;
+};
+
+/** Longer keys are never cached; they are longer than any name the name table accepts anyway. */
+constexpr int32 MaxKeyLength = 4096;
+constexpr int32 ThreadInitialSlotCount = 256;
+constexpr int32 ThreadMaxSlotCount = 8192;
+constexpr int32 SharedInitialSlotCount = 1024;
+constexpr int32 SharedMaxSlotCount = 32768;
+
+/** Decoding tables are kept apart per encoding, since their keys are the raw code units. */
+enum class ENameKeyEncoding : uint8
+{
+	Utf8,
+	Tchar,
+};
+
+struct FThreadNameTables
+{
+	TByteKeyTable<FName> Utf8Names{ ThreadInitialSlotCount, ThreadMaxSlotCount };
+	TByteKeyTable<FName> TcharNames{ ThreadInitialSlotCount, ThreadMaxSlotCount };
+	/** Keyed by the display index and number of the name; the text is stored after the key. */
+	TByteKeyTable<FNameUtf8> Texts{ ThreadInitialSlotCount, ThreadMaxSlotCount };
+};
+
+FThreadNameTables& GetThreadTables()
+{
+	static thread_local FThreadNameTables tables;
+	return tables;
+}
+
+struct FSharedNameTables
+{
+	FRWLock Lock;
+	TByteKeyTable<FName> Utf8Names{ SharedInitialSlotCount, SharedMaxSlotCount };
+	TByteKeyTable<FName> TcharNames{ SharedInitialSlotCount, SharedMaxSlotCount };
+};
+
+FSharedNameTables& GetSharedTables()
+{
+	static FSharedNameTables tables;
+	return tables;
+}
+
+template <typename MakeNameType>
+FName FindOrAddName(
+	const ENameKeyEncoding encoding, const void* const key, const int32 byte_length,
+	MakeNameType&& make_name)
+{
+	if (byte_length > MaxKeyLength)
+	{
+		return make_name();
+	}
+
+	const uint64 hash = Detail::HashBytes(key, byte_length);
+
+	FThreadNameTables& thread_tables = GetThreadTables();
+	TByteKeyTable<FName>& thread_names =
+		encoding == ENameKeyEncoding::Utf8 ? thread_tables.Utf8Names : thread_tables.TcharNames;
+	if (const FName* const name = thread_names.Find(hash, key, byte_length))
+	{
+		return *name;
+	}
+
+	FSharedNameTables& shared_tables = GetSharedTables();
+	TByteKeyTable<FName>& shared_names =
+		encoding == ENameKeyEncoding::Utf8 ? shared_tables.Utf8Names : shared_tables.TcharNames;
+
+	FName name;
+	bool found = false;
+	{
+		FReadScopeLock lock(shared_tables.Lock);
+		if (const FName* const shared_name = shared_names.Find(hash, key, byte_length))
+		{
+			name = *shared_name;
+			found = true;
+		}
+	}
+
+	if (!found)
+	{
+		name = make_name();
+
+		FWriteScopeLock lock(shared_tables.Lock);
+		if (shared_names.Find(hash, key, byte_length) == nullptr)
+		{
+			shared_names.Add(hash, key, byte_length) = name;
+		}
+	}
+
+	thread_names.Add(hash, key, byte_length) = name;
+	return name;
+}
+} // namespace
+
+FName FNameCache::FindOrAdd(const ANSICHAR* const text, const int32 length)
+{
+	return FindOrAddName(ENameKeyEncoding::Utf8, text, length, [text, length]() {
+		const FUTF8ToTCHAR converted{ text, length };
+		return FName(converted.Length(), converted.Get());
+	});
+}
+
+FName FNameCache::FindOrAdd(const TCHAR* const text, const int32 length)
+{
+	return FindOrAddName(
+		ENameKeyEncoding::Tchar, text, length * static_cast<int32>(sizeof(TCHAR)),
+		[text, length]() { return FName(length, text); });
+}
+
+FNameUtf8 FNameCache::ToUtf8(const FName& name)
+{
+	const uint64 key =
+		(static_cast<uint64>(name.GetDisplayIndex().ToUnstableInt()) << 32) |
+		static_cast<uint32>(name.GetNumber());
+	const uint64 hash = Detail::HashBytes(&key, sizeof(key));
+
+	TByteKeyTable<FNameUtf8>& texts = GetThreadTables().Texts;
+	if (const FNameUtf8* const text = texts.Find(hash, &key, sizeof(key)))
+	{
+		return *text;
+	}
+
+	const FString name_string = name.ToString();
+	const FTCHARToUTF8 converted{ *name_string, name_string.Len() };
+
+	ANSICHAR* stored = nullptr;
+	FNameUtf8& text = texts.Add(hash, &key, sizeof(key), &stored, converted.Length());
+	FMemory::Memcpy(stored, converted.Get(), converted.Length());
+	text = { stored, converted.Length() };
+
+	return text;
+}
+} // namespace Json
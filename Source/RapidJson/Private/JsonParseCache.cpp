@@ -0,0 +1,119 @@
+#include "JsonParseCache.h"
+
+namespace Json
+{
+FParseCache::FParseCache(const SIZE_T budget_bytes)
+	: BudgetBytes(budget_bytes)
+{
+}
+
+FParseCache::~FParseCache()
+{
+	Empty();
+}
+
+void FParseCache::SetBudget(const SIZE_T budget_bytes)
+{
+	FScopeLock lock(&Mutex);
+	BudgetBytes = budget_bytes;
+	EvictToBudget();
+}
+
+void FParseCache::Empty()
+{
+	FScopeLock lock(&Mutex);
+
+	for (FEntry* entry = Newest; entry != nullptr;)
+	{
+		FEntry* const older = entry->Older;
+		delete entry;
+		entry = older;
+	}
+
+	Entries.Reset();
+	Newest = nullptr;
+	Oldest = nullptr;
+	Stats.ResidentBytes = 0;
+	Stats.EntryCount = 0;
+}
+
+FParseCacheStats FParseCache::GetStats() const
+{
+	FScopeLock lock(&Mutex);
+	return Stats;
+}
+
+TSharedPtr<const void, ESPMode::ThreadSafe> FParseCache::Find(const FKey& key)
+{
+	FScopeLock lock(&Mutex);
+
+	FEntry* const* const found = Entries.Find(key);
+	if (found == nullptr)
+	{
+		++Stats.Misses;
+		return nullptr;
+	}
+
+	++Stats.Hits;
+	Unlink(*found);
+	LinkAsNewest(*found);
+	return (*found)->Value;
+}
+
+TSharedPtr<const void, ESPMode::ThreadSafe> FParseCache::Add(
+	const FKey& key, TSharedPtr<const void, ESPMode::ThreadSafe> value, const SIZE_T cost)
+{
+	FScopeLock lock(&Mutex);
+
+	if (FEntry* const* const existing = Entries.Find(key))
+	{
+		return (*existing)->Value;
+	}
+
+	// An entry larger than the whole budget would only evict everything else and then itself.
+	if (cost > BudgetBytes)
+	{
+		return value;
+	}
+
+	FEntry* const entry = new FEntry{ key, value, cost, nullptr, nullptr };
+	Entries.Add(key, entry);
+	LinkAsNewest(entry);
+
+	Stats.ResidentBytes += cost;
+	++Stats.EntryCount;
+	EvictToBudget();
+
+	return value;
+}
+
+void FParseCache::Unlink(FEntry* const entry)
+{
+	(entry->Newer != nullptr ? entry->Newer->Older : Newest) = entry->Older;
+	(entry->Older != nullptr ? entry->Older->Newer : Oldest) = entry->Newer;
+	entry->Newer = nullptr;
+	entry->Older = nullptr;
+}
+
+void FParseCache::LinkAsNewest(FEntry* const entry)
+{
+	entry->Older = Newest;
+	(Newest != nullptr ? Newest->Newer : Oldest) = entry;
+	Newest = entry;
+}
+
+void FParseCache::EvictToBudget()
+{
+	while (Stats.ResidentBytes > BudgetBytes && Oldest != nullptr)
+	{
+		FEntry* const victim = Oldest;
+		Unlink(victim);
+		Entries.Remove(victim->Key);
+
+		Stats.ResidentBytes -= victim->Cost;
+		--Stats.EntryCount;
+		++Stats.Evictions;
+		delete victim;
+	}
+}
+} // namespace Json
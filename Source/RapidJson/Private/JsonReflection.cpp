@@ -0,0 +1,963 @@
+#include "JsonReflection.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace Json
+{
+namespace
+{
+FCriticalSection& GetPlanMutex()
+{
+	static FCriticalSection mutex;
+	return mutex;
+}
+
+TMap<const UStruct*, TUniquePtr<FStructPlan>>& GetPlans()
+{
+	static TMap<const UStruct*, TUniquePtr<FStructPlan>> plans;
+	return plans;
+}
+
+TArray<ANSICHAR> EncodeUtf8(const FString& text)
+{
+	const FTCHARToUTF8 converted{ *text, text.Len() };
+	return TArray<ANSICHAR>(converted.Get(), converted.Length());
+}
+
+bool Utf8Equals(const TArray<ANSICHAR>& text, const ANSICHAR* const other, const rapidjson::SizeType length)
+{
+	return text.Num() == static_cast<int32>(length) &&
+		FMemory::Memcmp(text.GetData(), other, length) == 0;
+}
+
+void BuildEnumEntries(const UEnum* const enum_type, FPropertyValuePlan& plan)
+{
+	const int32 count = enum_type->NumEnums() - (enum_type->ContainsExistingMax() ? 1 : 0);
+	for (int32 index = 0; index < count; ++index)
+	{
+		plan.EnumEntries.Add({ enum_type->GetValueByIndex(index),
+			EncodeUtf8(enum_type->GetNameStringByIndex(index)) });
+	}
+}
+
+bool IsMapKeyKind(const EPropertyPlanKind kind)
+{
+	switch (kind)
+	{
+	case EPropertyPlanKind::Int8:
+	case EPropertyPlanKind::Int16:
+	case EPropertyPlanKind::Int32:
+	case EPropertyPlanKind::Int64:
+	case EPropertyPlanKind::UInt8:
+	case EPropertyPlanKind::UInt16:
+	case EPropertyPlanKind::UInt32:
+	case EPropertyPlanKind::UInt64:
+	case EPropertyPlanKind::Enum:
+	case EPropertyPlanKind::String:
+	case EPropertyPlanKind::Name:
+		return true;
+	default:
+		return false;
+	}
+}
+
+const FStructPlan& FindOrBuildPlan(const UStruct* type);
+
+/** Resolves how `property` is encoded. Returns false for properties with no JSON form. */
+bool BuildValuePlan(const FProperty* const property, FPropertyValuePlan& plan)
+{
+	plan.Property = property;
+
+	if (CastField<FBoolProperty>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Bool;
+		return true;
+	}
+
+	if (const FEnumProperty* const enum_property = CastField<FEnumProperty>(property))
+	{
+		plan.Kind = EPropertyPlanKind::Enum;
+		plan.Underlying = enum_property->GetUnderlyingProperty();
+		BuildEnumEntries(enum_property->GetEnum(), plan);
+		return true;
+	}
+
+	if (const FByteProperty* const byte_property = CastField<FByteProperty>(property))
+	{
+		if (byte_property->Enum != nullptr)
+		{
+			plan.Kind = EPropertyPlanKind::Enum;
+			plan.Underlying = byte_property;
+			BuildEnumEntries(byte_property->Enum, plan);
+		}
+		else
+		{
+			plan.Kind = EPropertyPlanKind::UInt8;
+		}
+		return true;
+	}
+
+	if (CastField<FInt8Property>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Int8;
+	}
+	else if (CastField<FInt16Property>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Int16;
+	}
+	else if (CastField<FIntProperty>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Int32;
+	}
+	else if (CastField<FInt64Property>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Int64;
+	}
+	else if (CastField<FUInt16Property>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::UInt16;
+	}
+	else if (CastField<FUInt32Property>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::UInt32;
+	}
+	else if (CastField<FUInt64Property>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::UInt64;
+	}
+	else if (CastField<FFloatProperty>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Float;
+	}
+	else if (CastField<FDoubleProperty>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Double;
+	}
+	else if (CastField<FStrProperty>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::String;
+	}
+	else if (CastField<FNameProperty>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Name;
+	}
+	else if (CastField<FTextProperty>(property) != nullptr)
+	{
+		plan.Kind = EPropertyPlanKind::Text;
+	}
+	else if (const FStructProperty* const struct_property = CastField<FStructProperty>(property))
+	{
+		plan.Kind = EPropertyPlanKind::Struct;
+		plan.Struct = &FindOrBuildPlan(struct_property->Struct);
+	}
+	else if (const FArrayProperty* const array_property = CastField<FArrayProperty>(property))
+	{
+		plan.Kind = EPropertyPlanKind::Array;
+		plan.Element = MakeUnique<FPropertyValuePlan>();
+		return BuildValuePlan(array_property->Inner, *plan.Element);
+	}
+	else if (const FSetProperty* const set_property = CastField<FSetProperty>(property))
+	{
+		plan.Kind = EPropertyPlanKind::Set;
+		plan.Element = MakeUnique<FPropertyValuePlan>();
+		return BuildValuePlan(set_property->ElementProp, *plan.Element);
+	}
+	else if (const FMapProperty* const map_property = CastField<FMapProperty>(property))
+	{
+		plan.Kind = EPropertyPlanKind::Map;
+		plan.Element = MakeUnique<FPropertyValuePlan>();
+		plan.Value = MakeUnique<FPropertyValuePlan>();
+		return BuildValuePlan(map_property->KeyProp, *plan.Element) &&
+			IsMapKeyKind(plan.Element->Kind) && BuildValuePlan(map_property->ValueProp, *plan.Value);
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void BuildStructPlan(const UStruct* const type, FStructPlan& plan)
+{
+	plan.Type = type;
+
+	for (TFieldIterator<FProperty> iterator{ type }; iterator; ++iterator)
+	{
+		const FProperty* const property = *iterator;
+		if (property->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated))
+		{
+			continue;
+		}
+
+		FPropertyFieldPlan field;
+		field.Key = EncodeUtf8(property->GetAuthoredName());
+		field.Offset = property->GetOffset_ForInternal();
+
+		bool supported = false;
+		if (property->ArrayDim > 1)
+		{
+			field.Value.Kind = EPropertyPlanKind::StaticArray;
+			field.Value.Property = property;
+			field.Value.ArrayDim = property->ArrayDim;
+			field.Value.ElementSize = property->ElementSize;
+			field.Value.Element = MakeUnique<FPropertyValuePlan>();
+			supported = BuildValuePlan(property, *field.Value.Element);
+		}
+		else
+		{
+			supported = BuildValuePlan(property, field.Value);
+		}
+
+		if (!supported)
+		{
+			UE_LOG(
+				LogRapidJson, Verbose, TEXT("Skipping %s::%s, which has no JSON form."),
+				*type->GetName(), *property->GetName());
+			continue;
+		}
+
+		plan.Fields.Add(MoveTemp(field));
+	}
+}
+
+const FStructPlan& FindOrBuildPlan(const UStruct* const type)
+{
+	FScopeLock lock(&GetPlanMutex());
+
+	if (const TUniquePtr<FStructPlan>* const plan = GetPlans().Find(type))
+	{
+		return **plan;
+	}
+
+	// Registered before it is built, so that types nesting themselves (e.g. through an array)
+	// refer to the plan being built instead of recursing forever.
+	FStructPlan& plan = *GetPlans().Add(type, MakeUnique<FStructPlan>());
+	BuildStructPlan(type, plan);
+
+	return plan;
+}
+
+const TCHAR* DescribeKind(const EPropertyPlanKind kind)
+{
+	switch (kind)
+	{
+	case EPropertyPlanKind::Bool:
+		return TEXT("a bool");
+	case EPropertyPlanKind::Float:
+	case EPropertyPlanKind::Double:
+		return TEXT("a real");
+	case EPropertyPlanKind::Enum:
+	case EPropertyPlanKind::String:
+	case EPropertyPlanKind::Name:
+	case EPropertyPlanKind::Text:
+		return TEXT("a string");
+	case EPropertyPlanKind::Struct:
+	case EPropertyPlanKind::Map:
+		return TEXT("an object");
+	case EPropertyPlanKind::StaticArray:
+	case EPropertyPlanKind::Array:
+	case EPropertyPlanKind::Set:
+		return TEXT("an array");
+	default:
+		return TEXT("an integer");
+	}
+}
+
+/** The value of the next parse event goes to `Address`, encoded as `Plan`; no plan skips it. */
+struct FReadTarget
+{
+	const FPropertyValuePlan* Plan = nullptr;
+	void* Address = nullptr;
+};
+
+/**
+ * rapidjson SAX handler decoding straight into reflected memory.
+ *
+ * Every open object or array is a frame. Objects get the target of their next value from the
+ * preceding key, arrays make room for one more element per value. Values that have nowhere to go
+ * (unknown members, values of the wrong type) are skipped along with everything nested in them.
+ **/
+class FStructReadHandler
+{
+public:
+	FStructReadHandler(const FPropertyValuePlan& root, void* const data)
+		: Root{ &root, data }
+	{
+	}
+
+	/** A failed parse leaves frames open, whose scratch values must still be added and freed. */
+	~FStructReadHandler()
+	{
+		while (Frames.Num() > 0)
+		{
+			CloseFrame(Frames.Pop(false));
+		}
+	}
+
+	bool Null()
+	{
+		if (SkipDepth == 0)
+		{
+			TakeTarget();
+		}
+		return true;
+	}
+
+	bool Bool(const bool value)
+	{
+		if (SkipDepth > 0)
+		{
+			return true;
+		}
+
+		const FReadTarget target = TakeTarget();
+		if (target.Plan == nullptr)
+		{
+			return true;
+		}
+
+		if (target.Plan->Kind == EPropertyPlanKind::Bool)
+		{
+			static_cast<const FBoolProperty*>(target.Plan->Property)->SetPropertyValue(target.Address, value);
+		}
+		else
+		{
+			LogMismatch(*target.Plan, TEXT("a bool"));
+		}
+		return true;
+	}
+
+	bool Int(const int value)
+	{
+		return Signed(value);
+	}
+
+	bool Uint(const unsigned value)
+	{
+		return Signed(value);
+	}
+
+	bool Int64(const int64_t value)
+	{
+		return Signed(value);
+	}
+
+	bool Uint64(const uint64_t value)
+	{
+		if (value <= static_cast<uint64_t>(TNumericLimits<int64>::Max()))
+		{
+			return Signed(static_cast<int64>(value));
+		}
+
+		if (SkipDepth > 0)
+		{
+			return true;
+		}
+
+		const FReadTarget target = TakeTarget();
+		if (target.Plan == nullptr)
+		{
+			return true;
+		}
+
+		switch (target.Plan->Kind)
+		{
+		case EPropertyPlanKind::UInt64:
+			*static_cast<uint64*>(target.Address) = value;
+			break;
+		case EPropertyPlanKind::Float:
+			*static_cast<float*>(target.Address) = static_cast<float>(value);
+			break;
+		case EPropertyPlanKind::Double:
+			*static_cast<double*>(target.Address) = static_cast<double>(value);
+			break;
+		default:
+			LogMismatch(*target.Plan, TEXT("an unsigned, 64-bit integer"));
+			break;
+		}
+		return true;
+	}
+
+	bool Double(const double value)
+	{
+		if (SkipDepth > 0)
+		{
+			return true;
+		}
+
+		const FReadTarget target = TakeTarget();
+		if (target.Plan == nullptr)
+		{
+			return true;
+		}
+
+		switch (target.Plan->Kind)
+		{
+		case EPropertyPlanKind::Float:
+			*static_cast<float*>(target.Address) = static_cast<float>(value);
+			break;
+		case EPropertyPlanKind::Double:
+			*static_cast<double*>(target.Address) = value;
+			break;
+		default:
+			LogMismatch(*target.Plan, TEXT("a real"));
+			break;
+		}
+		return true;
+	}
+
+	bool RawNumber(const ANSICHAR*, rapidjson::SizeType, bool)
+	{
+		// Only produced with kParseNumbersAsStringsFlag, which is never used here.
+		check(false);
+		return false;
+	}
+
+	bool String(const ANSICHAR* const value, const rapidjson::SizeType length, bool)
+	{
+		if (SkipDepth > 0)
+		{
+			return true;
+		}
+
+		const FReadTarget target = TakeTarget();
+		if (target.Plan == nullptr)
+		{
+			return true;
+		}
+
+		switch (target.Plan->Kind)
+		{
+		case EPropertyPlanKind::String:
+			*static_cast<FString*>(target.Address) = DecodeUtf8(value, length);
+			break;
+		case EPropertyPlanKind::Name:
+			*static_cast<FName*>(target.Address) = FNameCache::FindOrAdd(value, static_cast<int32>(length));
+			break;
+		case EPropertyPlanKind::Text:
+			*static_cast<FText*>(target.Address) = FText::FromString(DecodeUtf8(value, length));
+			break;
+		case EPropertyPlanKind::Enum:
+			ReadEnumName(*target.Plan, target.Address, value, length);
+			break;
+		default:
+			LogMismatch(*target.Plan, TEXT("a string"));
+			break;
+		}
+		return true;
+	}
+
+	bool StartObject()
+	{
+		if (SkipDepth > 0)
+		{
+			++SkipDepth;
+			return true;
+		}
+
+		const FReadTarget target = TakeTarget();
+		if (target.Plan == nullptr)
+		{
+			SkipDepth = 1;
+			return true;
+		}
+
+		switch (target.Plan->Kind)
+		{
+		case EPropertyPlanKind::Struct:
+			break;
+		case EPropertyPlanKind::Map:
+			FScriptMapHelper{ static_cast<const FMapProperty*>(target.Plan->Property), target.Address }
+				.EmptyValues();
+			break;
+		default:
+			LogMismatch(*target.Plan, TEXT("an object"));
+			SkipDepth = 1;
+			return true;
+		}
+
+		OpenFrame(target);
+		return true;
+	}
+
+	bool Key(const ANSICHAR* const key, const rapidjson::SizeType length, bool)
+	{
+		if (SkipDepth > 0)
+		{
+			return true;
+		}
+
+		FFrame& frame = Frames.Last();
+		frame.Pending = frame.Plan->Kind == EPropertyPlanKind::Struct
+			? FindField(frame, key, length)
+			: AddMapPair(frame, key, length);
+		return true;
+	}
+
+	bool EndObject(rapidjson::SizeType)
+	{
+		if (SkipDepth > 0)
+		{
+			--SkipDepth;
+			return true;
+		}
+
+		CloseFrame(Frames.Pop(false));
+		return true;
+	}
+
+	bool StartArray()
+	{
+		if (SkipDepth > 0)
+		{
+			++SkipDepth;
+			return true;
+		}
+
+		const FReadTarget target = TakeTarget();
+		if (target.Plan == nullptr)
+		{
+			SkipDepth = 1;
+			return true;
+		}
+
+		switch (target.Plan->Kind)
+		{
+		case EPropertyPlanKind::StaticArray:
+			break;
+		case EPropertyPlanKind::Array:
+		{
+			// Keeps the allocation, as `DeserializeFromJson` does when decoding into an object.
+			FScriptArrayHelper helper{ static_cast<const FArrayProperty*>(target.Plan->Property), target.Address };
+			helper.EmptyValues(helper.Num());
+			break;
+		}
+		case EPropertyPlanKind::Set:
+			FScriptSetHelper{ static_cast<const FSetProperty*>(target.Plan->Property), target.Address }
+				.EmptyElements();
+			break;
+		default:
+			LogMismatch(*target.Plan, TEXT("an array"));
+			SkipDepth = 1;
+			return true;
+		}
+
+		OpenFrame(target);
+		return true;
+	}
+
+	bool EndArray(rapidjson::SizeType)
+	{
+		if (SkipDepth > 0)
+		{
+			--SkipDepth;
+			return true;
+		}
+
+		CloseFrame(Frames.Pop(false));
+		return true;
+	}
+
+private:
+	struct FFrame
+	{
+		const FPropertyValuePlan* Plan;
+		void* Address;
+		/** Next field of a struct, or next element of a static array. */
+		int32 Index = 0;
+		/** Target of the value following the last key of an object. */
+		FReadTarget Pending;
+		/** Element of a set or key of a map being decoded, before it is added. */
+		void* ScratchKey = nullptr;
+		/** Value of a map being decoded, before it is added. */
+		void* ScratchValue = nullptr;
+		/** Whether the scratch values hold an element to add once the next one starts. */
+		bool HasScratchElement = false;
+	};
+
+	/**
+	 * Set elements and map pairs are decoded into scratch values of the frame and only then added,
+	 * so that the container stays hashed and a repeated element or key replaces the earlier one.
+	 **/
+	void OpenFrame(const FReadTarget& target)
+	{
+		FFrame& frame = Frames.AddDefaulted_GetRef();
+		frame.Plan = target.Plan;
+		frame.Address = target.Address;
+
+		if (target.Plan->Kind == EPropertyPlanKind::Set)
+		{
+			const FSetProperty* const property = static_cast<const FSetProperty*>(target.Plan->Property);
+			frame.ScratchKey = NewScratchValue(property->ElementProp);
+		}
+		else if (target.Plan->Kind == EPropertyPlanKind::Map)
+		{
+			const FMapProperty* const property = static_cast<const FMapProperty*>(target.Plan->Property);
+			frame.ScratchKey = NewScratchValue(property->KeyProp);
+			frame.ScratchValue = NewScratchValue(property->ValueProp);
+		}
+	}
+
+	static void CloseFrame(FFrame frame)
+	{
+		AddScratchElement(frame);
+
+		if (frame.Plan->Kind == EPropertyPlanKind::Set)
+		{
+			const FSetProperty* const property = static_cast<const FSetProperty*>(frame.Plan->Property);
+			DeleteScratchValue(property->ElementProp, frame.ScratchKey);
+		}
+		else if (frame.Plan->Kind == EPropertyPlanKind::Map)
+		{
+			const FMapProperty* const property = static_cast<const FMapProperty*>(frame.Plan->Property);
+			DeleteScratchValue(property->KeyProp, frame.ScratchKey);
+			DeleteScratchValue(property->ValueProp, frame.ScratchValue);
+		}
+	}
+
+	/** Adds the element decoded last, if any, and resets the scratch value for the next one. */
+	static void AddScratchElement(FFrame& frame)
+	{
+		if (!frame.HasScratchElement)
+		{
+			return;
+		}
+
+		frame.HasScratchElement = false;
+		if (frame.Plan->Kind == EPropertyPlanKind::Set)
+		{
+			const FSetProperty* const property = static_cast<const FSetProperty*>(frame.Plan->Property);
+			FScriptSetHelper{ property, frame.Address }.AddElement(frame.ScratchKey);
+			ResetScratchValue(property->ElementProp, frame.ScratchKey);
+		}
+		else
+		{
+			const FMapProperty* const property = static_cast<const FMapProperty*>(frame.Plan->Property);
+			FScriptMapHelper{ property, frame.Address }.AddPair(frame.ScratchKey, frame.ScratchValue);
+			ResetScratchValue(property->ValueProp, frame.ScratchValue);
+		}
+	}
+
+	static void* NewScratchValue(const FProperty* const property)
+	{
+		void* const value = FMemory::Malloc(property->GetSize(), property->GetMinAlignment());
+		property->InitializeValue(value);
+		return value;
+	}
+
+	static void ResetScratchValue(const FProperty* const property, void* const value)
+	{
+		property->DestroyValue(value);
+		property->InitializeValue(value);
+	}
+
+	static void DeleteScratchValue(const FProperty* const property, void* const value)
+	{
+		property->DestroyValue(value);
+		FMemory::Free(value);
+	}
+
+	static FString DecodeUtf8(const ANSICHAR* const text, const rapidjson::SizeType length)
+	{
+		const FUTF8ToTCHAR converted{ text, static_cast<int32>(length) };
+		return FString(converted.Length(), converted.Get());
+	}
+
+	static void LogMismatch(const FPropertyValuePlan& plan, const TCHAR* const got)
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Expected %s for %s, got %s."), DescribeKind(plan.Kind),
+			*plan.Property->GetName(), got);
+	}
+
+	FReadTarget TakeTarget()
+	{
+		if (Frames.Num() == 0)
+		{
+			const FReadTarget target = Root;
+			Root = FReadTarget{};
+			return target;
+		}
+
+		FFrame& frame = Frames.Last();
+		const FPropertyValuePlan& plan = *frame.Plan;
+		switch (plan.Kind)
+		{
+		case EPropertyPlanKind::StaticArray:
+			if (frame.Index >= plan.ArrayDim)
+			{
+				UE_LOG(
+					LogRapidJson, Error, TEXT("Expected at most %d elements for %s."), plan.ArrayDim,
+					*plan.Property->GetName());
+				return FReadTarget{};
+			}
+			return { plan.Element.Get(), static_cast<uint8*>(frame.Address) + frame.Index++ * plan.ElementSize };
+		case EPropertyPlanKind::Array:
+		{
+			FScriptArrayHelper helper{ static_cast<const FArrayProperty*>(plan.Property), frame.Address };
+			return { plan.Element.Get(), helper.GetRawPtr(helper.AddValue()) };
+		}
+		case EPropertyPlanKind::Set:
+			AddScratchElement(frame);
+			frame.HasScratchElement = true;
+			return { plan.Element.Get(), frame.ScratchKey };
+		default:
+		{
+			const FReadTarget target = frame.Pending;
+			frame.Pending = FReadTarget{};
+			return target;
+		}
+		}
+	}
+
+	/**
+	 * Members written from the same plan come in field order, so the field after the previous one
+	 * is tried before searching the others.
+	 **/
+	static FReadTarget FindField(FFrame& frame, const ANSICHAR* const key, const rapidjson::SizeType length)
+	{
+		const TArray<FPropertyFieldPlan>& fields = frame.Plan->Struct->Fields;
+
+		int32 found = INDEX_NONE;
+		if (fields.IsValidIndex(frame.Index) && Utf8Equals(fields[frame.Index].Key, key, length))
+		{
+			found = frame.Index;
+		}
+		else
+		{
+			found = fields.IndexOfByPredicate(
+				[&](const FPropertyFieldPlan& field) { return Utf8Equals(field.Key, key, length); });
+		}
+
+		if (found == INDEX_NONE)
+		{
+			return FReadTarget{};
+		}
+
+		frame.Index = found + 1;
+		return { &fields[found].Value, static_cast<uint8*>(frame.Address) + fields[found].Offset };
+	}
+
+	static FReadTarget AddMapPair(FFrame& frame, const ANSICHAR* const key, const rapidjson::SizeType length)
+	{
+		AddScratchElement(frame);
+
+		const FPropertyValuePlan& plan = *frame.Plan;
+		if (!ReadMapKey(*plan.Element, frame.ScratchKey, key, length))
+		{
+			return FReadTarget{};
+		}
+
+		frame.HasScratchElement = true;
+		return { plan.Value.Get(), frame.ScratchValue };
+	}
+
+	static bool ReadMapKey(
+		const FPropertyValuePlan& plan, void* const address, const ANSICHAR* const key,
+		const rapidjson::SizeType length)
+	{
+		switch (plan.Kind)
+		{
+		case EPropertyPlanKind::String:
+			*static_cast<FString*>(address) = DecodeUtf8(key, length);
+			return true;
+		case EPropertyPlanKind::Name:
+			*static_cast<FName*>(address) = FNameCache::FindOrAdd(key, static_cast<int32>(length));
+			return true;
+		case EPropertyPlanKind::Enum:
+			return ReadEnumName(plan, address, key, length);
+		default:
+			break;
+		}
+
+		// Keys are null-terminated by the reader, so they can be parsed in place.
+		ANSICHAR* end = nullptr;
+		if (plan.Kind == EPropertyPlanKind::UInt64)
+		{
+			const uint64 value = FCStringAnsi::Strtoui64(key, &end, 10);
+			if (length > 0 && end == key + length && key[0] != '-')
+			{
+				*static_cast<uint64*>(address) = value;
+				return true;
+			}
+		}
+		else
+		{
+			const int64 value = FCStringAnsi::Strtoi64(key, &end, 10);
+			if (length > 0 && end == key + length && StoreInteger(plan, address, value))
+			{
+				return true;
+			}
+		}
+
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Expected an integer key for %s, got \"%s\"."),
+			*plan.Property->GetName(), *DecodeUtf8(key, length));
+		return false;
+	}
+
+	static bool ReadEnumName(
+		const FPropertyValuePlan& plan, void* const address, const ANSICHAR* const name,
+		const rapidjson::SizeType length)
+	{
+		for (const FEnumPlanEntry& entry : plan.EnumEntries)
+		{
+			if (Utf8Equals(entry.Name, name, length))
+			{
+				plan.Underlying->SetIntPropertyValue(address, entry.Value);
+				return true;
+			}
+		}
+
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Unknown value \"%s\" for %s."), *DecodeUtf8(name, length),
+			*plan.Property->GetName());
+		return false;
+	}
+
+	template <typename IntegerType>
+	static bool StoreInRange(void* const address, const int64 value)
+	{
+		if (value < static_cast<int64>(TNumericLimits<IntegerType>::Min()) ||
+			value > static_cast<int64>(TNumericLimits<IntegerType>::Max()))
+		{
+			return false;
+		}
+
+		*static_cast<IntegerType*>(address) = static_cast<IntegerType>(value);
+		return true;
+	}
+
+	/** Stores `value` into an integer or enum target, failing when it does not fit. */
+	static bool StoreInteger(const FPropertyValuePlan& plan, void* const address, const int64 value)
+	{
+		switch (plan.Kind)
+		{
+		case EPropertyPlanKind::Int8:
+			return StoreInRange<int8>(address, value);
+		case EPropertyPlanKind::Int16:
+			return StoreInRange<int16>(address, value);
+		case EPropertyPlanKind::Int32:
+			return StoreInRange<int32>(address, value);
+		case EPropertyPlanKind::Int64:
+			*static_cast<int64*>(address) = value;
+			return true;
+		case EPropertyPlanKind::UInt8:
+			return StoreInRange<uint8>(address, value);
+		case EPropertyPlanKind::UInt16:
+			return StoreInRange<uint16>(address, value);
+		case EPropertyPlanKind::UInt32:
+			return StoreInRange<uint32>(address, value);
+		case EPropertyPlanKind::UInt64:
+			if (value < 0)
+			{
+				return false;
+			}
+			*static_cast<uint64*>(address) = static_cast<uint64>(value);
+			return true;
+		case EPropertyPlanKind::Enum:
+			plan.Underlying->SetIntPropertyValue(address, value);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool Signed(const int64 value)
+	{
+		if (SkipDepth > 0)
+		{
+			return true;
+		}
+
+		const FReadTarget target = TakeTarget();
+		if (target.Plan == nullptr)
+		{
+			return true;
+		}
+
+		switch (target.Plan->Kind)
+		{
+		case EPropertyPlanKind::Float:
+			*static_cast<float*>(target.Address) = static_cast<float>(value);
+			break;
+		case EPropertyPlanKind::Double:
+			*static_cast<double*>(target.Address) = static_cast<double>(value);
+			break;
+		case EPropertyPlanKind::Bool:
+		case EPropertyPlanKind::String:
+		case EPropertyPlanKind::Name:
+		case EPropertyPlanKind::Text:
+		case EPropertyPlanKind::Struct:
+		case EPropertyPlanKind::StaticArray:
+		case EPropertyPlanKind::Array:
+		case EPropertyPlanKind::Set:
+		case EPropertyPlanKind::Map:
+			LogMismatch(*target.Plan, TEXT("an integer"));
+			break;
+		default:
+			if (!StoreInteger(*target.Plan, target.Address, value))
+			{
+				UE_LOG(
+					LogRapidJson, Error, TEXT("Integer %lld is out of range for %s."),
+					static_cast<long long>(value), *target.Plan->Property->GetName());
+			}
+			break;
+		}
+		return true;
+	}
+
+	FReadTarget Root;
+	TArray<FFrame, TInlineAllocator<16>> Frames;
+	/** Depth of the value being skipped, 0 when not skipping. */
+	int32 SkipDepth = 0;
+};
+
+template <typename SourceEncodingType>
+void ParseStruct(
+	const typename SourceEncodingType::Ch* const json, const UStruct* const type, void* const data)
+{
+	JSON_UTILS_PARSE_SCOPE();
+
+	FPropertyValuePlan root;
+	root.Kind = EPropertyPlanKind::Struct;
+	root.Struct = &FStructPlan::Get(type);
+
+	FStructReadHandler handler{ root, data };
+	rapidjson::GenericStringStream<SourceEncodingType> stream{ json };
+	rapidjson::GenericReader<SourceEncodingType, rapidjson::UTF8<>, FCrtAllocator> reader;
+
+	const rapidjson::ParseResult result = reader.Parse(stream, handler);
+	JSON_UTILS_STAT_ADD(ParsedDocuments, 1);
+	JSON_UTILS_STAT_ADD(ParsedBytes, stream.Tell() * sizeof(typename SourceEncodingType::Ch));
+	if (result.IsError())
+	{
+		const FString message = DescribeParseError(result, json);
+		UE_LOG(LogRapidJson, Error, TEXT("Could not parse JSON document: %s"), *message);
+		throw std::invalid_argument(TCHAR_TO_UTF8(*message));
+	}
+}
+} // namespace
+
+const FStructPlan& FStructPlan::Get(const UStruct* const type)
+{
+	return FindOrBuildPlan(type);
+}
+
+void FStructPlan::ResetCache()
+{
+	FScopeLock lock(&GetPlanMutex());
+	GetPlans().Empty();
+}
+
+void DeserializeStructFromJson(const ANSICHAR* const json, const UStruct* const type, void* const data)
+{
+	ParseStruct<rapidjson::UTF8<>>(json, type, data);
+}
+
+void DeserializeStructFromJson(const TCHAR* const json, const UStruct* const type, void* const data)
+{
+	ParseStruct<rapidjson::UTF16<>>(json, type, data);
+}
+} // namespace Json
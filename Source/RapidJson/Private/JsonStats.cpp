@@ -0,0 +1,99 @@
+#include "JsonStats.h"
+
+#include <atomic>
+
+#if JSON_UTILS_STATS
+DEFINE_STAT(STAT_RapidJson_Parse);
+DEFINE_STAT(STAT_RapidJson_Encode);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Allocations"), STAT_RapidJson_Allocations, STATGROUP_RapidJson);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Transcodes"), STAT_RapidJson_Transcodes, STATGROUP_RapidJson);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Member lookups"), STAT_RapidJson_MemberLookups, STATGROUP_RapidJson);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Member compares"), STAT_RapidJson_MemberCompares, STATGROUP_RapidJson);
+
+// Byte counts are 64-bit, since a long session easily moves more than 4 GiB through the plugin.
+DECLARE_QWORD_ACCUMULATOR_STAT(TEXT("Allocated bytes"), STAT_RapidJson_AllocatedBytes, STATGROUP_RapidJson);
+DECLARE_QWORD_ACCUMULATOR_STAT(TEXT("Parsed bytes"), STAT_RapidJson_ParsedBytes, STATGROUP_RapidJson);
+DECLARE_QWORD_ACCUMULATOR_STAT(TEXT("Encoded bytes"), STAT_RapidJson_EncodedBytes, STATGROUP_RapidJson);
+#endif
+
+namespace Json
+{
+namespace
+{
+/** Relaxed, since the totals are only ever read as a whole, long after being added to. */
+std::atomic<uint64> Totals[static_cast<int32>(EStat::Count)];
+
+uint64 LoadTotal(const EStat stat)
+{
+	return Totals[static_cast<int32>(stat)].load(std::memory_order_relaxed);
+}
+} // namespace
+
+namespace Detail
+{
+void AddStat(const EStat stat, const uint64 amount)
+{
+	Totals[static_cast<int32>(stat)].fetch_add(amount, std::memory_order_relaxed);
+
+#if JSON_UTILS_STATS
+	// Cycles reach the stat group through `SCOPE_CYCLE_COUNTER` instead.
+	switch (stat)
+	{
+	case EStat::Allocations:
+		INC_DWORD_STAT_BY(STAT_RapidJson_Allocations, amount);
+		break;
+	case EStat::AllocatedBytes:
+		INC_QWORD_STAT_BY(STAT_RapidJson_AllocatedBytes, amount);
+		break;
+	case EStat::Transcodes:
+		INC_DWORD_STAT_BY(STAT_RapidJson_Transcodes, amount);
+		break;
+	case EStat::MemberLookups:
+		INC_DWORD_STAT_BY(STAT_RapidJson_MemberLookups, amount);
+		break;
+	case EStat::MemberCompares:
+		INC_DWORD_STAT_BY(STAT_RapidJson_MemberCompares, amount);
+		break;
+	case EStat::ParsedBytes:
+		INC_QWORD_STAT_BY(STAT_RapidJson_ParsedBytes, amount);
+		break;
+	case EStat::EncodedBytes:
+		INC_QWORD_STAT_BY(STAT_RapidJson_EncodedBytes, amount);
+		break;
+	default:
+		break;
+	}
+#endif
+}
+} // namespace Detail
+
+FStatsSnapshot GetStats()
+{
+	const double seconds_per_cycle = FPlatformTime::GetSecondsPerCycle64();
+
+	FStatsSnapshot snapshot;
+	snapshot.Allocations = LoadTotal(EStat::Allocations);
+	snapshot.AllocatedBytes = LoadTotal(EStat::AllocatedBytes);
+	snapshot.Transcodes = LoadTotal(EStat::Transcodes);
+	snapshot.TranscodedBytes = LoadTotal(EStat::TranscodedBytes);
+	snapshot.MemberLookups = LoadTotal(EStat::MemberLookups);
+	snapshot.MemberCompares = LoadTotal(EStat::MemberCompares);
+	snapshot.ParsedDocuments = LoadTotal(EStat::ParsedDocuments);
+	snapshot.ParsedBytes = LoadTotal(EStat::ParsedBytes);
+	snapshot.ParseSeconds = LoadTotal(EStat::ParseCycles) * seconds_per_cycle;
+	snapshot.EncodedDocuments = LoadTotal(EStat::EncodedDocuments);
+	snapshot.EncodedBytes = LoadTotal(EStat::EncodedBytes);
+	snapshot.EncodeSeconds = LoadTotal(EStat::EncodeCycles) * seconds_per_cycle;
+
+	return snapshot;
+}
+
+void ResetStats()
+{
+	for (std::atomic<uint64>& total : Totals)
+	{
+		total.store(0, std::memory_order_relaxed);
+	}
+}
+} // namespace Json
@@ -0,0 +1,562 @@
+#include "RapidJsonBenchmarkCommandlet.h"
+
+#include <cstdlib>
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "JsonBenchmarkCorpus.h"
+#include "JsonUtils.h"
+#include "RapidJsonLog.h"
+
+namespace Json
+{
+namespace Benchmark
+{
+namespace
+{
+struct FAllocationCounts
+{
+	int64 Allocations = 0;
+	int64 Bytes = 0;
+};
+
+/** Where the allocations made on this thread are counted, while a benchmark is being counted. */
+thread_local FAllocationCounts* CountedAllocations = nullptr;
+
+void CountAllocation(const SIZE_T size)
+{
+	if (FAllocationCounts* const counts = CountedAllocations)
+	{
+		++counts->Allocations;
+		counts->Bytes += static_cast<int64>(size);
+	}
+}
+
+/**
+ * Stands in for `GMalloc` while the benchmarks run, forwarding everything to the allocator it
+ * replaced. Blocks are never tracked, so either allocator can free them.
+ **/
+class FCountingMalloc final : public FMalloc
+{
+public:
+	explicit FCountingMalloc(FMalloc* const inner)
+		: Inner(inner)
+	{
+	}
+
+	FMalloc* GetInner() const
+	{
+		return Inner;
+	}
+
+	virtual void* Malloc(const SIZE_T count, const uint32 alignment) override
+	{
+		CountAllocation(count);
+		return Inner->Malloc(count, alignment);
+	}
+
+	virtual void* Realloc(void* const original, const SIZE_T count, const uint32 alignment) override
+	{
+		if (count > 0)
+		{
+			CountAllocation(count);
+		}
+		return Inner->Realloc(original, count, alignment);
+	}
+
+	virtual void Free(void* const original) override
+	{
+		Inner->Free(original);
+	}
+
+	virtual SIZE_T QuantizeSize(const SIZE_T count, const uint32 alignment) override
+	{
+		return Inner->QuantizeSize(count, alignment);
+	}
+
+	virtual bool GetAllocationSize(void* const original, SIZE_T& size) override
+	{
+		return Inner->GetAllocationSize(original, size);
+	}
+
+	virtual void Trim(const bool trim_thread_caches) override
+	{
+		Inner->Trim(trim_thread_caches);
+	}
+
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		Inner->SetupTLSCachesOnCurrentThread();
+	}
+
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		Inner->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+
+	virtual void UpdateStats() override
+	{
+		Inner->UpdateStats();
+	}
+
+	virtual void GetAllocatorStats(FGenericMemoryStats& stats) override
+	{
+		Inner->GetAllocatorStats(stats);
+	}
+
+	virtual void DumpAllocatorStats(FOutputDevice& output) override
+	{
+		Inner->DumpAllocatorStats(output);
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return Inner->IsInternallyThreadSafe();
+	}
+
+	virtual bool ValidateHeap() override
+	{
+		return Inner->ValidateHeap();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return Inner->GetDescriptiveName();
+	}
+
+private:
+	FMalloc* Inner;
+};
+
+/**
+ * rapidjson allocates with `std::malloc` rather than `FMemory`, so the raw benchmarks give it this
+ * allocator to have its allocations counted as well.
+ **/
+class FCountingCrtAllocator
+{
+public:
+	static const bool kNeedFree = true;
+
+	void* Malloc(const size_t size)
+	{
+		if (size == 0)
+		{
+			return nullptr;
+		}
+
+		CountAllocation(size);
+		return std::malloc(size);
+	}
+
+	void* Realloc(void* const original, const size_t original_size, const size_t new_size)
+	{
+		(void)original_size;
+		if (new_size == 0)
+		{
+			std::free(original);
+			return nullptr;
+		}
+
+		CountAllocation(new_size);
+		return std::realloc(original, new_size);
+	}
+
+	static void Free(void* const pointer)
+	{
+		std::free(pointer);
+	}
+};
+
+using FCountedDocument = rapidjson::GenericDocument<
+	rapidjson::UTF8<>, Json::TArenaAllocator<FCountingCrtAllocator>, FCountingCrtAllocator>;
+using FCountedValue = FCountedDocument::ValueType;
+using FCountedBuffer = rapidjson::GenericStringBuffer<rapidjson::UTF8<>, FCountingCrtAllocator>;
+using FCountedReader = rapidjson::GenericReader<rapidjson::UTF8<>, rapidjson::UTF8<>, FCountingCrtAllocator>;
+
+struct FResult
+{
+	FString Name;
+	/** Size of the compact UTF-8 document, which throughput is measured against in every case. */
+	int64 Bytes = 0;
+	int32 Iterations = 0;
+	double MedianSeconds = 0;
+	double BestSeconds = 0;
+	double MegabytesPerSecond = 0;
+	int64 AllocationsPerIteration = 0;
+	int64 AllocatedBytesPerIteration = 0;
+
+	JSON_DEFINE(
+		Name, Bytes, Iterations, MedianSeconds, BestSeconds, MegabytesPerSecond,
+		AllocationsPerIteration, AllocatedBytesPerIteration)
+};
+
+struct FReport
+{
+	FString Platform;
+	FString Configuration;
+	FString Date;
+	int32 Scale = 0;
+	uint64 PeakUsedPhysical = 0;
+	TArray<FResult> Results;
+
+	JSON_DEFINE(Platform, Configuration, Date, Scale, PeakUsedPhysical, Results)
+};
+
+/** Benchmarks fold their results in here, so that the work they measure cannot be optimized away. */
+volatile int64 Sink = 0;
+
+class FRunner
+{
+public:
+	FRunner(const double min_seconds, const FString& filter)
+		: MinSeconds(min_seconds)
+		, Filter(filter)
+	{
+	}
+
+	/**
+	 * Runs `body` repeatedly for at least the minimum time. Its first call warms up caches and
+	 * thread-local buffers and is neither timed nor counted; allocations are then averaged over a
+	 * few untimed calls, so that counting does not slow down the timed ones.
+	 **/
+	void Run(const FString& name, const int64 bytes, TFunctionRef<void()> body)
+	{
+		if (!Filter.IsEmpty() && !name.Contains(Filter))
+		{
+			return;
+		}
+
+		body();
+
+		FAllocationCounts counts;
+		CountedAllocations = &counts;
+		for (int32 iteration = 0; iteration < CountedIterations; ++iteration)
+		{
+			body();
+		}
+		CountedAllocations = nullptr;
+
+		counts.Allocations /= CountedIterations;
+		counts.Bytes /= CountedIterations;
+
+		TArray<double> samples;
+		const double end = FPlatformTime::Seconds() + MinSeconds;
+		do
+		{
+			const double start = FPlatformTime::Seconds();
+			body();
+			samples.Add(FPlatformTime::Seconds() - start);
+		} while (samples.Num() < MinIterations ||
+			(samples.Num() < MaxIterations && FPlatformTime::Seconds() < end));
+
+		samples.Sort();
+
+		FResult& result = Results.AddDefaulted_GetRef();
+		result.Name = name;
+		result.Bytes = bytes;
+		result.Iterations = samples.Num();
+		result.MedianSeconds = samples[samples.Num() / 2];
+		result.BestSeconds = samples[0];
+		result.MegabytesPerSecond = bytes / (1024.0 * 1024.0) / FMath::Max(result.MedianSeconds, 1e-9);
+		result.AllocationsPerIteration = counts.Allocations;
+		result.AllocatedBytesPerIteration = counts.Bytes;
+
+		UE_LOG(
+			LogRapidJson, Display, TEXT("%-32s %10.1f MB/s %10.3f ms %8lld allocations %12lld bytes"),
+			*name, result.MegabytesPerSecond, result.MedianSeconds * 1000.0, counts.Allocations,
+			counts.Bytes);
+	}
+
+	TArray<FResult> Results;
+
+private:
+	static constexpr int32 CountedIterations = 3;
+	static constexpr int32 MinIterations = 5;
+	static constexpr int32 MaxIterations = 100000;
+
+	double MinSeconds;
+	FString Filter;
+};
+
+/** Reads every value the way code consuming a DOM would, returning a checksum. */
+int64 Visit(const FCountedValue& value)
+{
+	int64 sum = 0;
+	switch (value.GetType())
+	{
+	case rapidjson::kObjectType:
+		for (const auto& member : value.GetObject())
+		{
+			sum += member.name.GetStringLength() + Visit(member.value);
+		}
+		return sum;
+	case rapidjson::kArrayType:
+		for (const auto& element : value.GetArray())
+		{
+			sum += Visit(element);
+		}
+		return sum;
+	case rapidjson::kStringType:
+		return value.GetStringLength();
+	case rapidjson::kNumberType:
+		return value.IsInt64() ? value.GetInt64() : static_cast<int64>(value.GetDouble());
+	case rapidjson::kTrueType:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/** Benchmarks rapidjson on its own: SAX parsing, DOM parsing and reading, and writing. */
+void RunRaw(FRunner& runner, const FString& corpus, const TArray<ANSICHAR>& text)
+{
+	const int64 bytes = text.Num() - 1;
+
+	runner.Run(corpus + TEXT("/reader"), bytes, [&text]() {
+		FCountedReader reader;
+		rapidjson::BaseReaderHandler<> handler;
+		rapidjson::StringStream stream{ text.GetData() };
+		Sink += reader.Parse(stream, handler).IsError() ? 0 : 1;
+	});
+
+	runner.Run(corpus + TEXT("/dom_parse"), bytes, [&text, bytes]() {
+		FCountedDocument document;
+		document.GetAllocator().Reserve(static_cast<size_t>(bytes));
+		document.Parse(text.GetData(), static_cast<size_t>(bytes));
+		Sink += document.HasParseError() ? 0 : 1;
+	});
+
+	FCountedDocument document;
+	document.Parse(text.GetData(), static_cast<size_t>(bytes));
+	if (document.HasParseError())
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Could not parse corpus %s: %s"), *corpus,
+			*DescribeParseError(document, text.GetData()));
+		return;
+	}
+
+	runner.Run(corpus + TEXT("/dom_access"), bytes, [&document]() { Sink += Visit(document); });
+
+	runner.Run(corpus + TEXT("/writer"), bytes, [&document]() {
+		FCountedBuffer buffer;
+		rapidjson::Writer<FCountedBuffer, rapidjson::UTF8<>, rapidjson::UTF8<>, FCountingCrtAllocator> writer{
+			buffer
+		};
+		document.Accept(writer);
+		Sink += buffer.GetSize();
+	});
+
+	runner.Run(corpus + TEXT("/pretty_writer"), bytes, [&document]() {
+		FCountedBuffer buffer;
+		rapidjson::PrettyWriter<FCountedBuffer, rapidjson::UTF8<>, rapidjson::UTF8<>, FCountingCrtAllocator>
+			writer{ buffer };
+		document.Accept(writer);
+		Sink += buffer.GetSize();
+	});
+}
+
+/** Benchmarks the typed API on `data`, then rapidjson on its own on the same document. */
+template <typename DataType>
+void RunTyped(FRunner& runner, const FString& corpus, const DataType& data)
+{
+	const FString text = SerializeToJson(data);
+	const FTCHARToUTF8 converted{ *text, text.Len() };
+
+	TArray<ANSICHAR> utf8;
+	utf8.Reserve(converted.Length() + 1);
+	utf8.Append(converted.Get(), converted.Length());
+	utf8.Add('\0');
+	const int64 bytes = converted.Length();
+
+	runner.Run(corpus + TEXT("/serialize"), bytes, [&data]() { Sink += SerializeToJson(data).Len(); });
+
+	runner.Run(corpus + TEXT("/serialize_pretty"), bytes, [&data]() {
+		Sink += SerializeToPrettyJson(data).Len();
+	});
+
+	runner.Run(corpus + TEXT("/deserialize_utf8"), bytes, [&utf8]() {
+		const DataType decoded = DeserializeFromJson<DataType>(utf8.GetData());
+		Sink += reinterpret_cast<UPTRINT>(&decoded);
+	});
+
+	runner.Run(corpus + TEXT("/deserialize_utf16"), bytes, [&text]() {
+		const DataType decoded = DeserializeFromJson<DataType>(*text);
+		Sink += reinterpret_cast<UPTRINT>(&decoded);
+	});
+
+	DataType reused;
+	runner.Run(corpus + TEXT("/deserialize_into"), bytes, [&utf8, &reused]() {
+		DeserializeFromJson(utf8.GetData(), reused);
+		Sink += reinterpret_cast<UPTRINT>(&reused);
+	});
+
+	RunRaw(runner, corpus, utf8);
+}
+
+/** Adds the raw benchmarks for every JSON file in `directory`. */
+void RunFiles(FRunner& runner, const FString& directory)
+{
+	TArray<FString> file_names;
+	IFileManager::Get().FindFiles(file_names, *(directory / TEXT("*.json")), true, false);
+	file_names.Sort();
+
+	for (const FString& file_name : file_names)
+	{
+		TArray<uint8> bytes;
+		if (!FFileHelper::LoadFileToArray(bytes, *(directory / file_name)))
+		{
+			UE_LOG(LogRapidJson, Error, TEXT("Could not read corpus %s."), *file_name);
+			continue;
+		}
+
+		TArray<ANSICHAR> text;
+		text.Reserve(bytes.Num() + 1);
+		text.Append(reinterpret_cast<const ANSICHAR*>(bytes.GetData()), bytes.Num());
+		text.Add('\0');
+
+		RunRaw(runner, TEXT("file/") + FPaths::GetBaseFilename(file_name), text);
+	}
+}
+
+/** Returns the number of benchmarks that got slower than `tolerance` allows, or allocate more. */
+int32 CompareWithBaseline(const FReport& report, const FString& path, const float tolerance)
+{
+	FString text;
+	if (!FFileHelper::LoadFileToString(text, *path))
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Could not read baseline %s."), *path);
+		return 1;
+	}
+
+	const FTCHARToUTF8 converted{ *text, text.Len() };
+	Json::TDocument<rapidjson::UTF8<>> document;
+	document.Parse(converted.Get(), static_cast<size_t>(converted.Length()));
+	if (document.HasParseError())
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Could not parse baseline %s: %s"), *path,
+			*DescribeParseError(document));
+		return 1;
+	}
+
+	FReport baseline;
+	Deserializer::FromJson(document, baseline);
+	if (baseline.Scale != report.Scale)
+	{
+		UE_LOG(
+			LogRapidJson, Warning, TEXT("The baseline was measured at scale %d, this run at scale %d."),
+			baseline.Scale, report.Scale);
+	}
+
+	int32 regression_count = 0;
+	for (const FResult& result : report.Results)
+	{
+		const FResult* const previous = baseline.Results.FindByPredicate(
+			[&result](const FResult& candidate) { return candidate.Name == result.Name; });
+		if (previous == nullptr || previous->MegabytesPerSecond <= 0)
+		{
+			continue;
+		}
+
+		const double change = result.MegabytesPerSecond / previous->MegabytesPerSecond - 1.0;
+		const bool slower = change < -tolerance;
+		const bool allocates_more = result.AllocationsPerIteration > previous->AllocationsPerIteration;
+		if (slower || allocates_more)
+		{
+			++regression_count;
+			UE_LOG(
+				LogRapidJson, Error, TEXT("%-32s %+6.1f%% throughput, %lld -> %lld allocations"),
+				*result.Name, change * 100.0, previous->AllocationsPerIteration,
+				result.AllocationsPerIteration);
+		}
+		else
+		{
+			UE_LOG(LogRapidJson, Display, TEXT("%-32s %+6.1f%% throughput"), *result.Name, change * 100.0);
+		}
+	}
+
+	return regression_count;
+}
+} // namespace
+} // namespace Benchmark
+} // namespace Json
+
+URapidJsonBenchmarkCommandlet::URapidJsonBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 URapidJsonBenchmarkCommandlet::Main(const FString& params)
+{
+	using namespace Json::Benchmark;
+
+	const TCHAR* const command_line = *params;
+
+	FString output = FPaths::ProjectSavedDir() / TEXT("RapidJsonBenchmark.json");
+	FString baseline;
+	FString filter;
+	FString corpus;
+	float tolerance = 0.1f;
+	float min_seconds = 0.5f;
+	int32 scale = 10;
+	FParse::Value(command_line, TEXT("Output="), output);
+	FParse::Value(command_line, TEXT("Baseline="), baseline);
+	FParse::Value(command_line, TEXT("Filter="), filter);
+	FParse::Value(command_line, TEXT("Corpus="), corpus);
+	FParse::Value(command_line, TEXT("Tolerance="), tolerance);
+	FParse::Value(command_line, TEXT("MinTime="), min_seconds);
+	FParse::Value(command_line, TEXT("Scale="), scale);
+	scale = FMath::Max(scale, 1);
+
+	// Never destroyed: another thread may still be calling through it after `GMalloc` is restored.
+	static FCountingMalloc* const counting_malloc = new FCountingMalloc(GMalloc);
+	FMalloc* const previous_malloc = GMalloc;
+	GMalloc = counting_malloc;
+
+	FRunner runner{ min_seconds, filter };
+	RunTyped(runner, TEXT("twitter"), MakeTimeline(scale));
+	RunTyped(runner, TEXT("canada"), MakeFeatureCollection(scale));
+	RunTyped(runner, TEXT("citm_catalog"), MakeCatalog(scale));
+	if (!corpus.IsEmpty())
+	{
+		RunFiles(runner, corpus);
+	}
+
+	GMalloc = previous_malloc;
+
+	FReport report;
+	report.Platform = FPlatformProperties::IniPlatformName();
+	report.Configuration = LexToString(FApp::GetBuildConfiguration());
+	report.Date = FDateTime::UtcNow().ToIso8601();
+	report.Scale = scale;
+	report.PeakUsedPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+	report.Results = MoveTemp(runner.Results);
+
+	if (!FFileHelper::SaveStringToFile(Json::SerializeToPrettyJson(report), *output))
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Could not write %s."), *output);
+		return 1;
+	}
+	UE_LOG(LogRapidJson, Display, TEXT("Wrote %d results to %s."), report.Results.Num(), *output);
+
+	if (!baseline.IsEmpty() && CompareWithBaseline(report, baseline, tolerance) > 0)
+	{
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "RapidJsonBenchmarkCommandlet.generated.h"
+
+/**
+ * Measures serialization, deserialization and raw rapidjson throughput on generated corpora,
+ * headless:
+ *
+ *   UE4Editor-Cmd <Project> -run=RapidJsonBenchmark [-Output=<file>] [-Baseline=<file>]
+ *     [-Tolerance=0.1] [-MinTime=0.5] [-Scale=10] [-Filter=<text>] [-Corpus=<directory>]
+ *
+ * Results go to `-Output` (Saved/RapidJsonBenchmark.json by default) as JSON, one entry per
+ * benchmark with its median time, throughput and allocations per iteration. Given the output of an
+ * earlier run as `-Baseline`, the commandlet fails when a benchmark lost more than `-Tolerance` of
+ * its throughput or allocates more than it did, so it can gate changes. `-Corpus` adds the raw
+ * benchmarks for every `.json` file in a directory, e.g. the original twitter, canada and
+ * citm_catalog files.
+ **/
+UCLASS()
+class URapidJsonBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	URapidJsonBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& params) override;
+};
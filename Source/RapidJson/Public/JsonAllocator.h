@@ -0,0 +1,379 @@
+#pragma once
+
+#include <cstdlib>
+#include <rapidjson/allocators.h>
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include "CoreMinimal.h"
+#include "FutureStd.h"
+#include "JsonStats.h"
+
+#ifndef JSON_UTILS_ARENA_INITIAL_CAPACITY
+#define JSON_UTILS_ARENA_INITIAL_CAPACITY (4 * 1024)
+#endif
+
+#ifndef JSON_UTILS_ARENA_MAX_CHUNK_CAPACITY
+#define JSON_UTILS_ARENA_MAX_CHUNK_CAPACITY (1024 * 1024)
+#endif
+
+namespace Json
+{
+#if JSON_UTILS_STATS
+/**
+ * Base allocator of the plugin's own documents, readers, writers and string buffers. It is
+ * rapidjson's `CrtAllocator`, except that allocations are counted.
+ **/
+class FCrtAllocator
+{
+public:
+	static const bool kNeedFree = true;
+
+	void* Malloc(const size_t size)
+	{
+		if (size == 0)
+		{
+			return nullptr;
+		}
+
+		JSON_UTILS_STAT_ADD(Allocations, 1);
+		JSON_UTILS_STAT_ADD(AllocatedBytes, size);
+		return std::malloc(size);
+	}
+
+	void* Realloc(void* const original, const size_t original_size, const size_t new_size)
+	{
+		(void)original_size;
+		if (new_size == 0)
+		{
+			std::free(original);
+			return nullptr;
+		}
+
+		JSON_UTILS_STAT_ADD(Allocations, 1);
+		JSON_UTILS_STAT_ADD(AllocatedBytes, new_size);
+		return std::realloc(original, new_size);
+	}
+
+	static void Free(void* const pointer)
+	{
+		std::free(pointer);
+	}
+};
+#else
+/**
+ * With nothing to count, rapidjson's own allocator is used, so that UTF-8 string buffers are
+ * `rapidjson::StringBuffer` and writers into them get the in-place number formatting that
+ * `Writer<StringBuffer>` is specialized for.
+ **/
+using FCrtAllocator = rapidjson::CrtAllocator;
+#endif
+
+/** Usage of a `TArenaAllocator`, in bytes unless stated otherwise. */
+struct FArenaStats
+{
+	/** Bytes handed out and not rewound, including alignment padding. */
+	SIZE_T Used = 0;
+	/** Highest `Used` since the arena was created or cleared. */
+	SIZE_T PeakUsed = 0;
+	/** Size of the chunks in use. Kept chunks are counted separately. */
+	SIZE_T Capacity = 0;
+	SIZE_T KeptCapacity = 0;
+	int32 Chunks = 0;
+	int32 KeptChunks = 0;
+	/** Calls to `Malloc` and `Realloc`, including those served in place. */
+	uint64 Allocations = 0;
+};
+
+/**
+ * Pool allocator for documents, as rapidjson's `MemoryPoolAllocator` but with chunks that grow
+ * geometrically from `JSON_UTILS_ARENA_INITIAL_CAPACITY` up to `JSON_UTILS_ARENA_MAX_CHUNK_CAPACITY`,
+ * so that small documents stay small and large ones take few chunks. `Reserve` takes a size hint,
+ * e.g. the length of the text about to be parsed.
+ *
+ * A long-lived arena can be shared by the documents of successive requests and rewound between
+ * them to a `Mark` taken beforehand. Chunks freed by `Rewind` are kept and reused by later
+ * allocations, until `Trim` or `Clear`:
+ *
+ *   Json::FDocumentAllocator arena;
+ *   const auto start = arena.Mark();
+ *   {
+ *       Json::TDocument<rapidjson::UTF8<>> document{ &arena };
+ *       ...
+ *   }
+ *   arena.Rewind(start);
+ *
+ * @note Nothing allocated after a mark may be used after rewinding to it.
+ **/
+template <typename BaseAllocatorType = FCrtAllocator>
+class TArenaAllocator
+{
+	struct FChunk
+	{
+		/** Bytes after the header. */
+		size_t Capacity;
+		size_t Size;
+		/** Previous chunk in use, or next kept chunk. */
+		FChunk* Next;
+	};
+
+public:
+	static const bool kNeedFree = false;
+
+	/** Position to rewind to. Only valid for the arena that made it. */
+	struct FMark
+	{
+		FChunk* Chunk = nullptr;
+		size_t Size = 0;
+		SIZE_T Used = 0;
+	};
+
+	explicit TArenaAllocator(
+		const size_t initial_capacity = JSON_UTILS_ARENA_INITIAL_CAPACITY,
+		BaseAllocatorType* const base_allocator = nullptr)
+		: InitialCapacity(FMath::Max<size_t>(RAPIDJSON_ALIGN(initial_capacity), 64))
+		, NextCapacity(InitialCapacity)
+		, BaseAllocator(base_allocator)
+	{
+	}
+
+	TArenaAllocator(const TArenaAllocator&) = delete;
+	TArenaAllocator& operator=(const TArenaAllocator&) = delete;
+
+	~TArenaAllocator()
+	{
+		Clear();
+		delete OwnBaseAllocator;
+	}
+
+	void* Malloc(size_t size)
+	{
+		if (size == 0)
+		{
+			return nullptr;
+		}
+
+		++Stats.Allocations;
+		size = RAPIDJSON_ALIGN(size);
+		if ((Head == nullptr || Head->Size + size > Head->Capacity) && !AddChunk(size))
+		{
+			return nullptr;
+		}
+
+		void* const block = GetData(Head) + Head->Size;
+		Head->Size += size;
+		Use(size);
+
+		return block;
+	}
+
+	void* Realloc(void* const original, size_t original_size, size_t new_size)
+	{
+		if (original == nullptr)
+		{
+			return Malloc(new_size);
+		}
+
+		if (new_size == 0)
+		{
+			return nullptr;
+		}
+
+		original_size = RAPIDJSON_ALIGN(original_size);
+		new_size = RAPIDJSON_ALIGN(new_size);
+		if (original_size >= new_size)
+		{
+			return original;
+		}
+
+		// The last block can grow in place, which is how a parsed string or array usually grows.
+		const size_t increment = new_size - original_size;
+		if (Head != nullptr && original == GetData(Head) + Head->Size - original_size &&
+			Head->Size + increment <= Head->Capacity)
+		{
+			++Stats.Allocations;
+			Head->Size += increment;
+			Use(increment);
+			return original;
+		}
+
+		void* const block = Malloc(new_size);
+		if (block != nullptr)
+		{
+			FMemory::Memcpy(block, original, original_size);
+		}
+
+		return block;
+	}
+
+	static void Free(void* const pointer)
+	{
+		(void)pointer;
+	}
+
+	/** Makes room for `size` bytes in a single chunk, e.g. ahead of parsing a document of that size. */
+	void Reserve(const size_t size)
+	{
+		const size_t aligned_size = RAPIDJSON_ALIGN(size);
+		if (aligned_size != 0 && (Head == nullptr || Head->Size + aligned_size > Head->Capacity))
+		{
+			AddChunk(aligned_size);
+		}
+	}
+
+	JSON_UTILS_NODISCARD FMark Mark() const
+	{
+		FMark mark;
+		mark.Chunk = Head;
+		mark.Size = Head != nullptr ? Head->Size : 0;
+		mark.Used = Stats.Used;
+
+		return mark;
+	}
+
+	/** Releases everything allocated since `mark`, keeping the chunks for reuse. */
+	void Rewind(const FMark& mark)
+	{
+		while (Head != mark.Chunk)
+		{
+			check(Head != nullptr);
+
+			FChunk* const previous = Head->Next;
+			Keep(Head);
+			Head = previous;
+		}
+
+		if (Head != nullptr)
+		{
+			Head->Size = mark.Size;
+		}
+
+		Stats.Used = mark.Used;
+	}
+
+	/** Frees the chunks kept by `Rewind`. */
+	void Trim()
+	{
+		while (Kept != nullptr)
+		{
+			FChunk* const next = Kept->Next;
+			Stats.KeptCapacity -= Kept->Capacity;
+			--Stats.KeptChunks;
+			BaseAllocator->Free(Kept);
+			Kept = next;
+		}
+	}
+
+	/** Frees every chunk and starts growing from the initial capacity again. */
+	void Clear()
+	{
+		Rewind(FMark{});
+		Trim();
+
+		NextCapacity = InitialCapacity;
+		Stats = FArenaStats{};
+	}
+
+	JSON_UTILS_NODISCARD const FArenaStats& GetStats() const
+	{
+		return Stats;
+	}
+
+	/** As in `MemoryPoolAllocator`. */
+	JSON_UTILS_NODISCARD size_t Capacity() const
+	{
+		return Stats.Capacity;
+	}
+
+	JSON_UTILS_NODISCARD size_t Size() const
+	{
+		return Stats.Used;
+	}
+
+private:
+	static uint8* GetData(FChunk* const chunk)
+	{
+		return reinterpret_cast<uint8*>(chunk) + RAPIDJSON_ALIGN(sizeof(FChunk));
+	}
+
+	void Use(const size_t size)
+	{
+		Stats.Used += size;
+		Stats.PeakUsed = FMath::Max(Stats.PeakUsed, Stats.Used);
+	}
+
+	/** Keeps `chunk` sorted by capacity, largest first, so that reuse starts from the largest. */
+	void Keep(FChunk* const chunk)
+	{
+		Stats.Capacity -= chunk->Capacity;
+		--Stats.Chunks;
+		Stats.KeptCapacity += chunk->Capacity;
+		++Stats.KeptChunks;
+
+		FChunk** link = &Kept;
+		while (*link != nullptr && (*link)->Capacity > chunk->Capacity)
+		{
+			link = &(*link)->Next;
+		}
+
+		chunk->Next = *link;
+		*link = chunk;
+	}
+
+	/** Starts a chunk of at least `size` bytes, reusing the largest kept chunk if it fits. */
+	bool AddChunk(const size_t size)
+	{
+		FChunk* chunk = nullptr;
+		if (Kept != nullptr && Kept->Capacity >= size)
+		{
+			chunk = Kept;
+			Kept = chunk->Next;
+			Stats.KeptCapacity -= chunk->Capacity;
+			--Stats.KeptChunks;
+		}
+		else
+		{
+			if (BaseAllocator == nullptr)
+			{
+				OwnBaseAllocator = BaseAllocator = new BaseAllocatorType();
+			}
+
+			const size_t capacity = FMath::Max(size, NextCapacity);
+			chunk = static_cast<FChunk*>(BaseAllocator->Malloc(RAPIDJSON_ALIGN(sizeof(FChunk)) + capacity));
+			if (chunk == nullptr)
+			{
+				return false;
+			}
+
+			chunk->Capacity = capacity;
+			NextCapacity = FMath::Min<size_t>(
+				FMath::Max(NextCapacity * 2, capacity), JSON_UTILS_ARENA_MAX_CHUNK_CAPACITY);
+		}
+
+		chunk->Size = 0;
+		chunk->Next = Head;
+		Head = chunk;
+
+		Stats.Capacity += chunk->Capacity;
+		++Stats.Chunks;
+
+		return true;
+	}
+
+	FChunk* Head = nullptr;
+	FChunk* Kept = nullptr;
+	size_t InitialCapacity;
+	size_t NextCapacity;
+	BaseAllocatorType* BaseAllocator;
+	BaseAllocatorType* OwnBaseAllocator = nullptr;
+	FArenaStats Stats;
+};
+
+/** Allocator of the values in the plugin's own documents. */
+using FDocumentAllocator = TArenaAllocator<FCrtAllocator>;
+
+template <typename EncodingType>
+using TDocument = rapidjson::GenericDocument<EncodingType, FDocumentAllocator, FCrtAllocator>;
+
+template <typename EncodingType>
+using TStringBuffer = rapidjson::GenericStringBuffer<EncodingType, FCrtAllocator>;
+} // namespace Json
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+namespace Base64
+{
+/** Number of characters, padding included, that `byte_count` bytes encode to. */
+RAPIDJSON_API SIZE_T EncodedLength(SIZE_T byte_count);
+
+/** Writes `EncodedLength(count)` characters of standard, padded base64 to `output`. */
+RAPIDJSON_API void Encode(const uint8* bytes, SIZE_T count, ANSICHAR* output);
+RAPIDJSON_API void Encode(const uint8* bytes, SIZE_T count, TCHAR* output);
+
+/** Number of bytes `text` decodes to; padding is optional. */
+RAPIDJSON_API SIZE_T DecodedSize(const ANSICHAR* text, SIZE_T length);
+RAPIDJSON_API SIZE_T DecodedSize(const TCHAR* text, SIZE_T length);
+
+/**
+ * Decodes `text` into `DecodedSize(text, length)` bytes at `output`.
+ *
+ * @note Returns false on characters outside the base64 alphabet, in which case the contents of
+ * `output` are unspecified.
+ **/
+JSON_UTILS_NODISCARD RAPIDJSON_API bool Decode(const ANSICHAR* text, SIZE_T length, uint8* output);
+JSON_UTILS_NODISCARD RAPIDJSON_API bool Decode(const TCHAR* text, SIZE_T length, uint8* output);
+} // namespace Base64
+
+/**
+ * Array of bytes or plain-old-data elements serialized as a single base64 string instead of an
+ * array of numbers.
+ *
+ * Encoding and decoding run over the raw bytes of the array with vectorized codecs where the
+ * target supports them; decoding writes straight into the array's storage, without an
+ * intermediate `FString` or JSON array.
+ *
+ * @note Elements are stored in the byte order of the machine, which is little-endian on every
+ * platform the engine ships on. Writers other than rapidjson's `Writer` and `PrettyWriter` receive
+ * the encoded text as an ordinary string.
+ **/
+template <typename ElementType>
+class TBase64Array
+{
+public:
+	static_assert(
+		TIsPODType<ElementType>::Value,
+		"Base64 arrays require elements that can be copied byte by byte.");
+
+	TBase64Array() = default;
+
+	explicit TBase64Array(TArray<ElementType> elements)
+		: Elements(MoveTemp(elements))
+	{
+	}
+
+	const TArray<ElementType>& GetElements() const
+	{
+		return Elements;
+	}
+
+	TArray<ElementType>& GetElements()
+	{
+		return Elements;
+	}
+
+	template <typename WriterType>
+	void ToJson(WriterType& writer) const
+	{
+		using CharacterType = typename WriterType::Ch;
+
+		const SIZE_T byte_count = static_cast<SIZE_T>(Elements.Num()) * sizeof(ElementType);
+		const SIZE_T length = Base64::EncodedLength(byte_count);
+
+		// One character of room on each side for the quotes of the raw value.
+		TArray<CharacterType> text;
+		text.SetNumUninitialized(static_cast<int32>(length + 2));
+		text[0] = '"';
+		text[static_cast<int32>(length + 1)] = '"';
+		Base64::Encode(reinterpret_cast<const uint8*>(Elements.GetData()), byte_count, text.GetData() + 1);
+
+		WriteText(writer, text.GetData(), length);
+	}
+
+private:
+	template <typename WriterType, typename CharacterType>
+	static auto WriteText(WriterType& writer, const CharacterType* quoted, const SIZE_T length) ->
+		typename TEnableIf<Traits::WriterTraits<WriterType>::Value>::Type
+	{
+		// The alphabet never needs escaping, so the quoted text can skip the string writer.
+		writer.RawValue(quoted, length + 2, rapidjson::kStringType);
+	}
+
+	template <typename WriterType, typename CharacterType>
+	static auto WriteText(WriterType& writer, const CharacterType* quoted, const SIZE_T length) ->
+		typename TEnableIf<!Traits::WriterTraits<WriterType>::Value>::Type
+	{
+		writer.String(quoted + 1, static_cast<rapidjson::SizeType>(length));
+	}
+
+	TArray<ElementType> Elements;
+};
+
+namespace Deserializer
+{
+namespace Detail
+{
+template <typename ElementType, typename EncodingType, typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TBase64Array<ElementType>& data)
+{
+	TArray<ElementType>& elements = data.GetElements();
+
+	if (!json_value.IsString())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Expected a base64 string, got %s."), *TypeToString(json_value));
+		return;
+	}
+
+	const auto* const text = json_value.GetString();
+	const SIZE_T length = json_value.GetStringLength();
+	const SIZE_T byte_count = Base64::DecodedSize(text, length);
+
+	if (byte_count % sizeof(ElementType) != 0)
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Base64 payload of %llu bytes is not a whole number of %llu-byte elements."),
+			static_cast<uint64>(byte_count), static_cast<uint64>(sizeof(ElementType)));
+		return;
+	}
+
+	elements.SetNumUninitialized(static_cast<int32>(byte_count / sizeof(ElementType)), false);
+	if (!Base64::Decode(text, length, reinterpret_cast<uint8*>(elements.GetData())))
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Invalid character in base64 string."));
+		elements.Reset();
+	}
+}
+} // namespace Detail
+} // namespace Deserializer
+} // namespace Json
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+/**
+ * Array of `JSON_DEFINE` or `JSON_EXTERNAL_DEFINE` records serialized column by column, as
+ * `{"cols":{"X":[...],"Y":[...]}}`, instead of as an array of objects.
+ *
+ * Every key is written once per column rather than once per record, which keeps large tabular
+ * exports small. Decoding looks each column up once and then fills that field of every record in
+ * a tight loop, writing straight into the rows of the array.
+ *
+ * @note All columns must have the same length. A column missing from the document is reported
+ * like a missing `JSON_DEFINE` member and stops decoding.
+ **/
+template <typename ElementType>
+class TColumnar
+{
+public:
+	static_assert(
+		Traits::HasJsonFields<ElementType>::Value,
+		"Columnar arrays require records declared with JSON_DEFINE or JSON_EXTERNAL_DEFINE.");
+
+	TColumnar() = default;
+
+	explicit TColumnar(TArray<ElementType> rows)
+		: Rows(MoveTemp(rows))
+	{
+	}
+
+	const TArray<ElementType>& GetRows() const
+	{
+		return Rows;
+	}
+
+	TArray<ElementType>& GetRows()
+	{
+		return Rows;
+	}
+
+	template <typename WriterType>
+	void ToJson(WriterType& writer) const
+	{
+		writer.StartObject();
+		writer.Key("cols");
+		writer.StartObject();
+
+		Detail::VisitFields(Prototype(), [&](const ANSICHAR* name, auto member) {
+			writer.Key(name);
+			writer.StartArray();
+			for (const ElementType& row : Rows)
+			{
+				Serializer::ToJson(writer, row.*member);
+			}
+			writer.EndArray();
+		});
+
+		writer.EndObject();
+		writer.EndObject();
+	}
+
+	/** Default record whose fields are visited when the array itself is empty. */
+	static const ElementType& Prototype()
+	{
+		static const ElementType prototype{};
+		return prototype;
+	}
+
+private:
+	TArray<ElementType> Rows;
+};
+
+namespace Deserializer
+{
+namespace Detail
+{
+template <typename ElementType, typename EncodingType, typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TColumnar<ElementType>& data)
+{
+	if (!json_value.IsObject())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Expected an object, got %s."), *TypeToString(json_value));
+		return;
+	}
+
+	const auto columns = Json::Detail::FindField(json_value, "cols");
+	if (columns == json_value.MemberEnd() || !columns->value.IsObject())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Expected a \"cols\" object holding the columns."));
+		return;
+	}
+
+	// Every column has to describe the same number of records.
+	int32 row_count = -1;
+	for (const auto& column : columns->value.GetObject())
+	{
+		const int32 column_size = column.value.IsArray() ? static_cast<int32>(column.value.Size()) : -1;
+		if (column_size < 0 || (row_count >= 0 && column_size != row_count))
+		{
+			UE_LOG(LogRapidJson, Error, TEXT("Columns must be arrays of equal length."));
+			return;
+		}
+		row_count = column_size;
+	}
+
+	TArray<ElementType>& rows = data.GetRows();
+	rows.SetNum(FMath::Max(row_count, 0), false);
+
+	bool succeeded = true;
+	Json::Detail::VisitFields(TColumnar<ElementType>::Prototype(), [&](const ANSICHAR* name, auto member) {
+		if (!succeeded)
+		{
+			return;
+		}
+
+		const auto column = Json::Detail::FindField(columns->value, name);
+		if (column == columns->value.MemberEnd())
+		{
+			UE_LOG(LogRapidJson, Error, TEXT("not found column %s"), UTF8_TO_TCHAR(name));
+			succeeded = false;
+			return;
+		}
+
+		const auto& values = column->value;
+		for (int32 index = 0; index < rows.Num(); ++index)
+		{
+			Deserializer::FromJson(values[static_cast<rapidjson::SizeType>(index)], rows[index].*member);
+		}
+	});
+}
+} // namespace Detail
+} // namespace Deserializer
+} // namespace Json
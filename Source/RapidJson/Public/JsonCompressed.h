@@ -0,0 +1,275 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "JsonUtils.h"
+
+struct z_stream_s;
+
+namespace Json
+{
+enum class EJsonCompression : uint8
+{
+	/** zlib framing (RFC 1950). */
+	Zlib,
+	/** gzip framing (RFC 1952), readable by command line tools. */
+	Gzip,
+};
+
+/**
+ * rapidjson output stream that deflates UTF-8 text into an archive as it is written.
+ *
+ * Text is gathered in a fixed-size chunk and compressed whenever the chunk fills up, so only one
+ * chunk of text and one chunk of compressed bytes are ever held in memory, whatever the size of
+ * the document.
+ *
+ * @note Call `Finish` once the document is complete; the destructor does it otherwise, but then
+ * errors can no longer be reported.
+ **/
+class RAPIDJSON_API FDeflateOutputStream
+{
+public:
+	typedef ANSICHAR Ch;
+
+	/** @param level zlib compression level from 0 to 9, or -1 for zlib's default. */
+	explicit FDeflateOutputStream(
+		FArchive& archive, EJsonCompression format = EJsonCompression::Gzip, int32 level = -1);
+	~FDeflateOutputStream();
+
+	FDeflateOutputStream(const FDeflateOutputStream&) = delete;
+	FDeflateOutputStream& operator=(const FDeflateOutputStream&) = delete;
+
+	void Put(const Ch character)
+	{
+		*Cursor++ = character;
+		if (Cursor == TextEnd)
+		{
+			Deflate(false);
+		}
+	}
+
+	/** Writers flush after every top-level value; compression carries on across them. */
+	void Flush()
+	{
+	}
+
+	/** Compresses the remaining text and writes the stream trailer. Returns false on error. */
+	bool Finish();
+
+	/** Number of bytes of text put into the stream so far, before compression. */
+	size_t GetWrittenSize() const
+	{
+		return Written + (Cursor - Text.GetData());
+	}
+
+	// Not implemented, as in rapidjson's own output streams.
+	Ch Peek() const
+	{
+		check(false);
+		return 0;
+	}
+
+	Ch Take()
+	{
+		check(false);
+		return 0;
+	}
+
+	size_t Tell() const
+	{
+		check(false);
+		return 0;
+	}
+
+	Ch* PutBegin()
+	{
+		check(false);
+		return nullptr;
+	}
+
+	size_t PutEnd(Ch*)
+	{
+		check(false);
+		return 0;
+	}
+
+private:
+	static constexpr int32 ChunkSize = 64 * 1024;
+
+	void Deflate(bool finish);
+
+	FArchive& Archive;
+	TUniquePtr<z_stream_s> Stream;
+	/** Heap buffers, so that a stream on the stack of a worker thread stays small. */
+	TArray<Ch> Text;
+	TArray<uint8> Compressed;
+	Ch* Cursor = nullptr;
+	Ch* TextEnd = nullptr;
+	/** Bytes of text handed to zlib, or dropped after a failure. */
+	size_t Written = 0;
+	bool Finished = false;
+	bool Failed = false;
+};
+
+/**
+ * rapidjson input stream that inflates zlib or gzip compressed UTF-8 text from an archive while
+ * it is being parsed. The framing is detected from the stream header.
+ *
+ * @note Corrupt or truncated data ends the text early, which the parser reports as a parse error.
+ **/
+class RAPIDJSON_API FInflateInputStream
+{
+public:
+	typedef ANSICHAR Ch;
+
+	explicit FInflateInputStream(FArchive& archive);
+	~FInflateInputStream();
+
+	FInflateInputStream(const FInflateInputStream&) = delete;
+	FInflateInputStream& operator=(const FInflateInputStream&) = delete;
+
+	Ch Peek() const
+	{
+		return *Current;
+	}
+
+	Ch Take()
+	{
+		const Ch character = *Current;
+		if (Current + 1 < TextEnd)
+		{
+			++Current;
+		}
+		else if (!Ended)
+		{
+			Consumed += TextEnd - Text.GetData();
+			Inflate();
+		}
+
+		return character;
+	}
+
+	size_t Tell() const
+	{
+		return Consumed + (Current - Text.GetData());
+	}
+
+	/** Whether the data could not be inflated, as opposed to holding malformed JSON. */
+	bool HasError() const
+	{
+		return Failed;
+	}
+
+	// Not implemented, as in rapidjson's own input streams.
+	void Put(Ch)
+	{
+		check(false);
+	}
+
+	void Flush()
+	{
+		check(false);
+	}
+
+	Ch* PutBegin()
+	{
+		check(false);
+		return nullptr;
+	}
+
+	size_t PutEnd(Ch*)
+	{
+		check(false);
+		return 0;
+	}
+
+private:
+	static constexpr int32 ChunkSize = 64 * 1024;
+
+	/** Refills `Text`; after the end of the data it holds a single terminating zero. */
+	void Inflate();
+
+	FArchive& Archive;
+	TUniquePtr<z_stream_s> Stream;
+	TArray<uint8> Compressed;
+	TArray<Ch> Text;
+	const Ch* Current = nullptr;
+	const Ch* TextEnd = nullptr;
+	size_t Consumed = 0;
+	/** No more text will come out of zlib. */
+	bool Drained = false;
+	/** `Text` holds the terminating zero. */
+	bool Ended = false;
+	bool Failed = false;
+};
+
+/**
+ * Serializes `data` as compressed UTF-8 JSON straight into `archive`, without materializing the
+ * text. Returns false if compression or the archive failed.
+ **/
+template <typename InputEncodingType = rapidjson::UTF8<>, typename DataType>
+bool SerializeToCompressedJson(
+	const DataType& data, FArchive& archive, const EJsonCompression format = EJsonCompression::Gzip,
+	const int32 level = -1)
+{
+	JSON_UTILS_ENCODE_SCOPE();
+
+	FDeflateOutputStream stream{ archive, format, level };
+	rapidjson::Writer<FDeflateOutputStream, InputEncodingType, rapidjson::UTF8<>, FCrtAllocator> writer{
+		stream
+	};
+
+	Serializer::ToJson(writer, data);
+	JSON_UTILS_STAT_ADD(EncodedDocuments, 1);
+	JSON_UTILS_STAT_ADD(EncodedBytes, stream.GetWrittenSize());
+
+	return stream.Finish();
+}
+
+/** Returns an empty array if compression failed, which no complete stream of either format is. */
+template <typename InputEncodingType = rapidjson::UTF8<>, typename DataType>
+JSON_UTILS_NODISCARD TArray<uint8> SerializeToCompressedJson(
+	const DataType& data, const EJsonCompression format = EJsonCompression::Gzip,
+	const int32 level = -1)
+{
+	TArray<uint8> bytes;
+	FMemoryWriter archive{ bytes };
+	if (!SerializeToCompressedJson<InputEncodingType>(data, archive, format, level))
+	{
+		bytes.Empty();
+	}
+
+	return bytes;
+}
+
+/** Decodes compressed JSON from `archive` into an existing object, inflating while parsing. */
+template <typename DataType>
+void DeserializeFromCompressedJson(FArchive& archive, DataType& data)
+{
+	FInflateInputStream stream{ archive };
+	Detail::DeserializeInto<DataType, rapidjson::UTF8<>>(stream, data);
+}
+
+template <typename DataType>
+void DeserializeFromCompressedJson(const TArray<uint8>& bytes, DataType& data)
+{
+	FMemoryReader archive{ bytes };
+	DeserializeFromCompressedJson(archive, data);
+}
+
+template <typename ContainerType>
+JSON_UTILS_NODISCARD ContainerType DeserializeFromCompressedJson(FArchive& archive)
+{
+	FInflateInputStream stream{ archive };
+	return Detail::Deserialize<ContainerType, rapidjson::UTF8<>>(stream);
+}
+
+template <typename ContainerType>
+JSON_UTILS_NODISCARD ContainerType DeserializeFromCompressedJson(const TArray<uint8>& bytes)
+{
+	FMemoryReader archive{ bytes };
+	return DeserializeFromCompressedJson<ContainerType>(archive);
+}
+} // namespace Json
@@ -0,0 +1,568 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonFields.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+namespace Detail
+{
+// The overloads below recurse into each other through field and element types, so they are all
+// declared up front.
+
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<Traits::HasJsonFields<DataType>::Value, bool>::Type;
+
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<
+	!Traits::HasJsonFields<DataType>::Value && Traits::TreatAsArray<DataType>::Value, bool>::Type;
+
+template <typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType>
+bool JsonEquals(
+	const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& lhs,
+	const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& rhs);
+
+template <typename DataType>
+bool JsonEquals(const TOptional<DataType>& lhs, const TOptional<DataType>& rhs);
+
+template <typename DataType>
+bool JsonEquals(const TSharedPtr<DataType>& lhs, const TSharedPtr<DataType>& rhs);
+
+template <typename DataType>
+bool JsonEquals(const TUniquePtr<DataType>& lhs, const TUniquePtr<DataType>& rhs);
+
+inline bool JsonEquals(const FString& lhs, const FString& rhs);
+inline bool JsonEquals(const FName& lhs, const FName& rhs);
+inline bool JsonEquals(const FText& lhs, const FText& rhs);
+inline bool JsonEquals(const float& lhs, const float& rhs);
+inline bool JsonEquals(const double& lhs, const double& rhs);
+
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<
+	!Traits::HasJsonFields<DataType>::Value && !Traits::TreatAsArray<DataType>::Value &&
+	!Traits::TreatAsObject<DataType>::Value && Traits::HasEqualityOperator<DataType>::Value,
+	bool>::Type;
+
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<
+	!Traits::HasJsonFields<DataType>::Value && !Traits::TreatAsArray<DataType>::Value &&
+	Traits::TreatAsObject<DataType>::Value,
+	bool>::Type;
+
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<
+	!Traits::HasJsonFields<DataType>::Value && !Traits::TreatAsArray<DataType>::Value &&
+	!Traits::TreatAsObject<DataType>::Value && !Traits::HasEqualityOperator<DataType>::Value,
+	bool>::Type;
+
+template <typename WriterType, typename DataType>
+auto WriteDelta(WriterType& writer, const DataType& current, const DataType& baseline) ->
+	typename TEnableIf<Traits::HasJsonFields<DataType>::Value>::Type;
+
+template <
+	typename WriterType, typename KeyType, typename ValueType, typename SetAllocatorType,
+	typename KeyFuncsType>
+void WriteDelta(
+	WriterType& writer, const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& current,
+	const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& baseline);
+
+template <typename WriterType, typename DataType>
+auto WriteDelta(WriterType& writer, const DataType& current, const DataType& baseline) ->
+	typename TEnableIf<!Traits::HasJsonFields<DataType>::Value>::Type;
+
+template <typename DataType, typename EncodingType, typename AllocatorType>
+auto ApplyMergePatch(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& patch, DataType& data) ->
+	typename TEnableIf<Traits::HasJsonFields<DataType>::Value>::Type;
+
+template <
+	typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType,
+	typename EncodingType, typename AllocatorType>
+void ApplyMergePatch(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& patch,
+	TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& data);
+
+template <typename DataType, typename EncodingType, typename AllocatorType>
+auto ApplyMergePatch(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& patch, DataType& data) ->
+	typename TEnableIf<!Traits::HasJsonFields<DataType>::Value>::Type;
+
+/**
+ * Tells whether two values would serialize to the same JSON. Defined fields, containers and
+ * pointers are compared member by member so nothing is encoded; types without `operator==` fall
+ * back to comparing their encodings, through buffers reused by every call on a thread.
+ **/
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<Traits::HasJsonFields<DataType>::Value, bool>::Type
+{
+	bool equal = true;
+	VisitFields(lhs, [&](const ANSICHAR*, auto member) {
+		equal = equal && JsonEquals(lhs.*member, rhs.*member);
+	});
+
+	return equal;
+}
+
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<
+	!Traits::HasJsonFields<DataType>::Value && Traits::TreatAsArray<DataType>::Value, bool>::Type
+{
+	auto rhs_iterator = std::begin(rhs);
+	const auto rhs_end = std::end(rhs);
+
+	for (const auto& element : lhs)
+	{
+		if (rhs_iterator == rhs_end || !JsonEquals(element, *rhs_iterator))
+		{
+			return false;
+		}
+
+		++rhs_iterator;
+	}
+
+	return rhs_iterator == rhs_end;
+}
+
+template <typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType>
+bool JsonEquals(
+	const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& lhs,
+	const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& rhs)
+{
+	if (lhs.Num() != rhs.Num())
+	{
+		return false;
+	}
+
+	for (const auto& pair : lhs)
+	{
+		const ValueType* const other = rhs.Find(pair.Key);
+		if (other == nullptr || !JsonEquals(pair.Value, *other))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename DataType>
+bool JsonEquals(const TOptional<DataType>& lhs, const TOptional<DataType>& rhs)
+{
+	if (lhs.IsSet() != rhs.IsSet())
+	{
+		return false;
+	}
+
+	return !lhs.IsSet() || JsonEquals(lhs.GetValue(), rhs.GetValue());
+}
+
+template <typename DataType>
+bool JsonEquals(const TSharedPtr<DataType>& lhs, const TSharedPtr<DataType>& rhs)
+{
+	if (lhs.IsValid() != rhs.IsValid())
+	{
+		return false;
+	}
+
+	return !lhs.IsValid() || lhs == rhs || JsonEquals(*lhs, *rhs);
+}
+
+template <typename DataType>
+bool JsonEquals(const TUniquePtr<DataType>& lhs, const TUniquePtr<DataType>& rhs)
+{
+	if (lhs.IsValid() != rhs.IsValid())
+	{
+		return false;
+	}
+
+	return !lhs.IsValid() || JsonEquals(*lhs, *rhs);
+}
+
+// `FString` and `FName` compare case-insensitively by default, which would hide edits that only
+// change case.
+inline bool JsonEquals(const FString& lhs, const FString& rhs)
+{
+	return lhs.Equals(rhs, ESearchCase::CaseSensitive);
+}
+
+inline bool JsonEquals(const FName& lhs, const FName& rhs)
+{
+	return lhs.IsEqual(rhs, ENameCase::CaseSensitive);
+}
+
+inline bool JsonEquals(const FText& lhs, const FText& rhs)
+{
+	return lhs.ToString().Equals(rhs.ToString(), ESearchCase::CaseSensitive);
+}
+
+// Floating point values compare by bit pattern: `-0.0 == 0.0` would lose the sign of zero, and a
+// NaN would never equal itself and so always count as changed.
+inline bool JsonEquals(const float& lhs, const float& rhs)
+{
+	return FMemory::Memcmp(&lhs, &rhs, sizeof(float)) == 0;
+}
+
+inline bool JsonEquals(const double& lhs, const double& rhs)
+{
+	return FMemory::Memcmp(&lhs, &rhs, sizeof(double)) == 0;
+}
+
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<
+	!Traits::HasJsonFields<DataType>::Value && !Traits::TreatAsArray<DataType>::Value &&
+	!Traits::TreatAsObject<DataType>::Value && Traits::HasEqualityOperator<DataType>::Value,
+	bool>::Type
+{
+	return lhs == rhs;
+}
+
+/** Pair containers other than `TMap` (e.g. `TSortedMap`, `TMultiMap`) are written in order. */
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<
+	!Traits::HasJsonFields<DataType>::Value && !Traits::TreatAsArray<DataType>::Value &&
+	Traits::TreatAsObject<DataType>::Value,
+	bool>::Type
+{
+	auto rhs_iterator = std::begin(rhs);
+	const auto rhs_end = std::end(rhs);
+
+	for (const auto& pair : lhs)
+	{
+		if (rhs_iterator == rhs_end || !JsonEquals(pair.Key, rhs_iterator->Key) ||
+			!JsonEquals(pair.Value, rhs_iterator->Value))
+		{
+			return false;
+		}
+
+		++rhs_iterator;
+	}
+
+	return rhs_iterator == rhs_end;
+}
+
+/** Output stream that checks what is written against an earlier encoding instead of storing it. */
+class FEncodingComparisonStream
+{
+public:
+	using Ch = ANSICHAR;
+
+	void Reset(const Ch* const expected, const size_t expected_size)
+	{
+		Expected = expected;
+		ExpectedSize = expected_size;
+		Position = 0;
+		Matching = true;
+	}
+
+	void Put(const Ch character)
+	{
+		Matching = Matching && Position < ExpectedSize && Expected[Position] == character;
+		++Position;
+	}
+
+	void Flush()
+	{
+	}
+
+	bool Matches() const
+	{
+		return Matching && Position == ExpectedSize;
+	}
+
+private:
+	const Ch* Expected = nullptr;
+	size_t ExpectedSize = 0;
+	size_t Position = 0;
+	bool Matching = true;
+};
+
+/**
+ * Buffers and writers of the encoding comparison. The writers keep their level stacks between
+ * calls, so comparisons allocate nothing once the buffer has grown to fit.
+ **/
+struct FEncodingComparisonScratch
+{
+	using BufferType = TStringBuffer<rapidjson::UTF8<>>;
+	using WriterType =
+		rapidjson::Writer<BufferType, rapidjson::UTF8<>, rapidjson::UTF8<>, FCrtAllocator>;
+	using ComparisonWriterType = rapidjson::Writer<
+		FEncodingComparisonStream, rapidjson::UTF8<>, rapidjson::UTF8<>, FCrtAllocator>;
+
+	BufferType Buffer;
+	FEncodingComparisonStream Comparison;
+	WriterType Writer{ Buffer };
+	ComparisonWriterType ComparisonWriter{ Comparison };
+
+	static FEncodingComparisonScratch& Get()
+	{
+		static thread_local FEncodingComparisonScratch scratch;
+		return scratch;
+	}
+};
+
+template <typename DataType>
+auto JsonEquals(const DataType& lhs, const DataType& rhs) ->
+	typename TEnableIf<
+	!Traits::HasJsonFields<DataType>::Value && !Traits::TreatAsArray<DataType>::Value &&
+	!Traits::TreatAsObject<DataType>::Value && !Traits::HasEqualityOperator<DataType>::Value,
+	bool>::Type
+{
+	FEncodingComparisonScratch& scratch = FEncodingComparisonScratch::Get();
+
+	scratch.Buffer.Clear();
+	scratch.Writer.Reset(scratch.Buffer);
+	Serializer::ToJson(scratch.Writer, lhs);
+
+	scratch.Comparison.Reset(scratch.Buffer.GetString(), scratch.Buffer.GetSize());
+	scratch.ComparisonWriter.Reset(scratch.Comparison);
+	Serializer::ToJson(scratch.ComparisonWriter, rhs);
+
+	return scratch.Comparison.Matches();
+}
+
+/**
+ * Writes the merge patch turning `baseline` into `current`. Defined types emit an object holding
+ * only their changed fields, recursing into nested defined types; maps emit their changed keys and
+ * `null` for removed ones; everything else is written whole.
+ **/
+template <typename WriterType, typename DataType>
+auto WriteDelta(WriterType& writer, const DataType& current, const DataType& baseline) ->
+	typename TEnableIf<Traits::HasJsonFields<DataType>::Value>::Type
+{
+	writer.StartObject();
+
+	VisitFields(current, [&](const ANSICHAR* name, auto member) {
+		if (!JsonEquals(current.*member, baseline.*member))
+		{
+			writer.Key(name);
+			WriteDelta(writer, current.*member, baseline.*member);
+		}
+	});
+
+	writer.EndObject();
+}
+
+/**
+ * Whether a value can encode as `null`. Merge patches use `null` to remove map entries, so such
+ * values cannot be written as map values of a delta.
+ **/
+template <typename> struct CanEncodeAsNull : Traits::FalseType
+{
+};
+
+template <typename DataType> struct CanEncodeAsNull<TOptional<DataType>> : Traits::TrueType
+{
+};
+
+template <typename DataType, ESPMode Mode>
+struct CanEncodeAsNull<TSharedPtr<DataType, Mode>> : Traits::TrueType
+{
+};
+
+template <typename DataType> struct CanEncodeAsNull<TUniquePtr<DataType>> : Traits::TrueType
+{
+};
+
+template <
+	typename WriterType, typename KeyType, typename ValueType, typename SetAllocatorType,
+	typename KeyFuncsType>
+void WriteDelta(
+	WriterType& writer, const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& current,
+	const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& baseline)
+{
+	static_assert(
+		!CanEncodeAsNull<ValueType>::Value,
+		"Map values that can encode as null would read back as removed entries.");
+
+	writer.StartObject();
+
+	for (const auto& pair : current)
+	{
+		const ValueType* const previous = baseline.Find(pair.Key);
+		if (previous == nullptr)
+		{
+			Serializer::Detail::InsertKeyValuePair(writer, pair.Key, pair.Value);
+		}
+		else if (!JsonEquals(pair.Value, *previous))
+		{
+			Serializer::Detail::WriteKey(writer, pair.Key);
+			WriteDelta(writer, pair.Value, *previous);
+		}
+	}
+
+	for (const auto& pair : baseline)
+	{
+		if (!current.Contains(pair.Key))
+		{
+			Serializer::Detail::WriteKey(writer, pair.Key);
+			writer.Null();
+		}
+	}
+
+	writer.EndObject();
+}
+
+template <typename WriterType, typename DataType>
+auto WriteDelta(WriterType& writer, const DataType& current, const DataType& baseline) ->
+	typename TEnableIf<!Traits::HasJsonFields<DataType>::Value>::Type
+{
+	Serializer::ToJson(writer, current);
+}
+
+/**
+ * Applies a merge patch to an existing value. Fields of defined types that are absent from the
+ * patch are left untouched, map entries set to `null` are removed and everything else is decoded
+ * in place with the regular deserializer.
+ **/
+template <typename DataType, typename EncodingType, typename AllocatorType>
+auto ApplyMergePatch(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& patch, DataType& data) ->
+	typename TEnableIf<Traits::HasJsonFields<DataType>::Value>::Type
+{
+	if (!patch.IsObject())
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Expected an object, got %s."),
+			*Deserializer::Detail::TypeToString(patch));
+		return;
+	}
+
+	const auto& patch_object = patch.GetObject();
+
+	// Patches usually carry a handful of fields, so scanning them per field beats building a
+	// lookup table.
+	VisitFields(data, [&](const ANSICHAR* name, auto member) {
+		for (const auto& patch_member : patch_object)
+		{
+			if (FieldNameEquals(
+				patch_member.name.GetString(), patch_member.name.GetStringLength(), name))
+			{
+				ApplyMergePatch(patch_member.value, data.*member);
+				break;
+			}
+		}
+	});
+}
+
+template <
+	typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType,
+	typename EncodingType, typename AllocatorType>
+void ApplyMergePatch(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& patch,
+	TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& data)
+{
+	if (!patch.IsObject())
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Expected an object, got %s."),
+			*Deserializer::Detail::TypeToString(patch));
+		return;
+	}
+
+	KeyType key = Deserializer::Detail::KeyExtractor<KeyType>::Default();
+	for (const auto& patch_member : patch.GetObject())
+	{
+		if (!Deserializer::Detail::KeyExtractor<KeyType>::Assign(patch_member.name, key))
+		{
+			continue;
+		}
+
+		if (patch_member.value.IsNull())
+		{
+			data.Remove(key);
+		}
+		else
+		{
+			ApplyMergePatch(patch_member.value, data.FindOrAdd(static_cast<const KeyType&>(key)));
+		}
+	}
+}
+
+template <typename DataType, typename EncodingType, typename AllocatorType>
+auto ApplyMergePatch(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& patch, DataType& data) ->
+	typename TEnableIf<!Traits::HasJsonFields<DataType>::Value>::Type
+{
+	Deserializer::FromJson(patch, data);
+}
+
+template <typename DataType, typename EncodingType, typename StreamType>
+void ApplyMergePatch(
+	StreamType& stream, DataType& data, const typename EncodingType::Ch* const source)
+{
+	TDocument<EncodingType> document;
+	ParseOrThrow(document, stream, source);
+
+	ApplyMergePatch(static_cast<const typename TDocument<EncodingType>::ValueType&>(document), data);
+}
+} // namespace Detail
+
+/**
+ * Serializes only what changed between `baseline` and `current`, as a JSON merge patch
+ * (RFC 7396). The result is `{}` when nothing changed.
+ *
+ * Comparing fields costs far less than encoding them, so replicating a large object whose
+ * fields rarely change mostly pays for the comparison. Keep the last state sent as the baseline
+ * and replace it after each delta.
+ *
+ * @note Only types listed with `JSON_DEFINE` or `JSON_EXTERNAL_DEFINE` are diffed field by field.
+ * Arrays are replaced whole, as merge patches have no way to address their elements.
+ **/
+template <
+	typename InputEncodingType = rapidjson::UTF8<>, typename OutputEncodingType = rapidjson::UTF8<>,
+	typename DataType>
+JSON_UTILS_NODISCARD FString SerializeDeltaToJson(const DataType& current, const DataType& baseline)
+{
+	static_assert(
+		Traits::HasJsonFields<DataType>::Value,
+		"Deltas require a type declared with JSON_DEFINE or JSON_EXTERNAL_DEFINE.");
+
+	JSON_UTILS_ENCODE_SCOPE();
+
+	TStringBuffer<OutputEncodingType> buffer;
+	rapidjson::Writer<decltype(buffer), InputEncodingType, OutputEncodingType, FCrtAllocator> writer{
+		buffer
+	};
+
+	Detail::WriteDelta(writer, current, baseline);
+	JSON_UTILS_STAT_ADD(EncodedDocuments, 1);
+	JSON_UTILS_STAT_ADD(EncodedBytes, buffer.GetSize());
+
+	return buffer.GetString();
+}
+
+/** Updates `data` in place from a merge patch produced by `SerializeDeltaToJson`. */
+template <typename DataType>
+void ApplyJsonMergePatch(const ANSICHAR* const patch, DataType& data)
+{
+	using EncodingType = rapidjson::UTF8<>;
+
+	rapidjson::GenericStringStream<EncodingType> string_stream{ patch };
+	Detail::ApplyMergePatch<DataType, EncodingType>(string_stream, data, patch);
+}
+
+template <typename DataType>
+void ApplyJsonMergePatch(const TCHAR* const patch, DataType& data)
+{
+	using EncodingType = rapidjson::UTF16<>;
+
+	rapidjson::GenericStringStream<EncodingType> string_stream{ patch };
+	Detail::ApplyMergePatch<DataType, EncodingType>(string_stream, data, patch);
+}
+
+template <typename DataType>
+void ApplyJsonMergePatch(const FString& patch, DataType& data)
+{
+	ApplyJsonMergePatch(*patch, data);
+}
+} // namespace Json
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "RapidJsonLog.h"
+#include "JsonAllocator.h"
+#include "JsonEnumTable.h"
 #include "JsonFwd.h"
+#include "JsonNameCache.h"
 
 namespace Json
 {
@@ -48,8 +51,21 @@ namespace
 constexpr const auto& FromJson = Detail::MakeOdrSafe<Detail::FromJsonFunctor>;
 }
 
+/**
+ * @note `Prepare` runs once before a container is filled, with the element count read from the
+ * document. It empties the container but keeps its allocation, then reserves room for every
+ * element, so filling the container never reallocates and decoding into an existing value reuses
+ * the storage of the previous decode.
+ **/
 struct DefaultInsertionPolicy
 {
+	template <typename ContainerType>
+	static void Prepare(ContainerType& container, int32 count)
+	{
+		container.Reset();
+		container.Reserve(count);
+	}
+
 	template <typename DataType, typename ContainerType>
 	static void Insert(DataType&& data, ContainerType& container)
 	{
@@ -57,13 +73,31 @@ struct DefaultInsertionPolicy
 	}
 };
 
+/**
+ * @note Map-like containers construct the value inside the node created for its key through
+ * `Emplace(key)`, which lets the decoder write into it directly instead of building a temporary
+ * value and moving it in. This is shared by `TMap`, `TMultiMap` and `TSortedMap`.
+ **/
 struct BackInsertionPolicy
 {
+	template <typename ContainerType>
+	static void Prepare(ContainerType& container, int32 count)
+	{
+		container.Reset();
+		container.Reserve(count);
+	}
+
 	template <typename DataType, typename ContainerType>
 	static void Insert(DataType&& data, ContainerType& container)
 	{
 		container.Add(MoveTemp(data));
 	}
+
+	template <typename KeyType, typename ContainerType>
+	static auto Emplace(KeyType&& key, ContainerType& container) -> decltype(container.Emplace(Forward<KeyType>(key)))
+	{
+		return container.Emplace(Forward<KeyType>(key));
+	}
 };
 
 namespace Detail
@@ -90,6 +124,33 @@ template <typename JsonValueType> FString TypeToString(const JsonValueType& valu
 	return "an unknown type";
 }
 
+/** Lets better_enums report a name that is not an enumerator, by throwing from `_from_string`. */
+template <typename EnumType, typename AllocatorType>
+EnumType EnumFromUnknownString(const rapidjson::GenericValue<rapidjson::UTF8<>, AllocatorType>& json_value)
+{
+	return EnumType::_from_string(json_value.GetString());
+}
+
+template <typename EnumType, typename AllocatorType>
+EnumType EnumFromUnknownString(const rapidjson::GenericValue<rapidjson::UTF16<>, AllocatorType>& json_value)
+{
+	return EnumType::_from_string(TCHAR_TO_UTF8(json_value.GetString()));
+}
+
+/** Looks up a `JSON_MAKE_ENUM` value by name, matching the document's characters directly. */
+template <typename EnumType, typename EncodingType, typename AllocatorType>
+EnumType EnumFromString(const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value)
+{
+	const int32 index = Json::Detail::TEnumNameTable<EnumType>::Get().Find(
+		json_value.GetString(), json_value.GetStringLength());
+	if (index == INDEX_NONE)
+	{
+		return EnumFromUnknownString<EnumType>(json_value);
+	}
+
+	return EnumType::_from_index_unchecked(static_cast<std::size_t>(index));
+}
+
 template <
 	typename StringType, typename InputEncodingType, typename OutputEncodingType,
 	typename EncodingType, typename AllocatorType>
@@ -98,7 +159,7 @@ template <
 	assert(value.IsString());
 
 	rapidjson::GenericStringStream<InputEncodingType> source{ value.GetString() };
-	rapidjson::GenericStringBuffer<OutputEncodingType> target;
+	TStringBuffer<OutputEncodingType> target;
 
 	using TranscoderType = rapidjson::Transcoder<InputEncodingType, OutputEncodingType>;
 
@@ -114,9 +175,29 @@ template <
 		return "";
 	}
 
+	JSON_UTILS_STAT_ADD(Transcodes, 1);
+	JSON_UTILS_STAT_ADD(TranscodedBytes, target.GetSize());
+
 	return target.GetString();
 }
 
+/**
+ * Overwrites `target` with the given string. The existing character buffer is reused whenever it
+ * is large enough, so repeatedly decoding into the same `FString` does not reallocate.
+ **/
+inline void AssignString(const ANSICHAR* source, rapidjson::SizeType length, FString& target)
+{
+	const FUTF8ToTCHAR converted{ source, static_cast<int32>(length) };
+	target.Reset(converted.Length());
+	target.AppendChars(converted.Get(), converted.Length());
+}
+
+inline void AssignString(const TCHAR* source, rapidjson::SizeType length, FString& target)
+{
+	target.Reset(static_cast<int32>(length));
+	target.AppendChars(source, static_cast<int32>(length));
+}
+
 template <typename DataType> struct ValueExtractor
 {
 	template <typename EncodingType, typename AllocatorType>
@@ -173,6 +254,45 @@ template <> struct ValueExtractor<uint32>
 	}
 };
 
+/**
+ * Narrow integers are range-checked against the 32-bit integer the reader parsed, so they never go
+ * through `int64` or `double`.
+ **/
+template <typename DataType> struct NarrowIntegerExtractor
+{
+	template <typename EncodingType, typename AllocatorType>
+	static DataType ExtractOrThrow(const rapidjson::GenericValue<EncodingType, AllocatorType>& value)
+	{
+		if (!value.IsInt() || value.GetInt() < TNumericLimits<DataType>::Min() ||
+			value.GetInt() > TNumericLimits<DataType>::Max())
+		{
+			UE_LOG(
+				LogRapidJson, Error, TEXT("Expected an integer between %d and %d, got %s."),
+				static_cast<int32>(TNumericLimits<DataType>::Min()),
+				static_cast<int32>(TNumericLimits<DataType>::Max()), *TypeToString(value));
+			return 0;
+		}
+
+		return static_cast<DataType>(value.GetInt());
+	}
+};
+
+template <> struct ValueExtractor<int8> : NarrowIntegerExtractor<int8>
+{
+};
+
+template <> struct ValueExtractor<uint8> : NarrowIntegerExtractor<uint8>
+{
+};
+
+template <> struct ValueExtractor<int16> : NarrowIntegerExtractor<int16>
+{
+};
+
+template <> struct ValueExtractor<uint16> : NarrowIntegerExtractor<uint16>
+{
+};
+
 template <> struct ValueExtractor<int64>
 {
 	template <typename EncodingType, typename AllocatorType>
@@ -203,6 +323,10 @@ template <> struct ValueExtractor<uint64>
 	}
 };
 
+/**
+ * The reader rounds every number exactly to `double`; narrowing that to `float` gives back the
+ * original value for any text written from a `float`.
+ **/
 template <> struct ValueExtractor<float>
 {
 	template <typename EncodingType, typename AllocatorType>
@@ -214,7 +338,7 @@ template <> struct ValueExtractor<float>
 			return 0;
 		}
 
-		return value.GetDouble();
+		return static_cast<float>(value.GetDouble());
 	}
 };
 
@@ -251,62 +375,33 @@ template <> struct ValueExtractor<long double>
 template <> struct ValueExtractor<FString>
 {
 	template <typename EncodingType, typename AllocatorType>
-	static auto ExtractOrThrow(const rapidjson::GenericValue<EncodingType, AllocatorType>& value)
-		-> typename TEnableIf<
-		TIsSame<typename EncodingType::Ch, ANSICHAR>::Value, FString>::Type
+	static FString ExtractOrThrow(const rapidjson::GenericValue<EncodingType, AllocatorType>& value)
 	{
 		if (!value.IsString())
 		{
 			UE_LOG(LogRapidJson, Error, TEXT("Expected a string, got %s."), *TypeToString(value));
-			return FString::Empty;
+			return FString();
 		}
 
-		return TCHAR_TO_UTF8(value.GetString());
-	}
-
-	template <typename EncodingType, typename AllocatorType>
-	static auto ExtractOrThrow(const rapidjson::GenericValue<EncodingType, AllocatorType>& value)
-		-> typename TEnableIf<
-		TIsSame<typename EncodingType::Ch, TCHAR>::Value, FString>::Type
-	{
-		if (!value.IsString())
-		{
-			UE_LOG(LogRapidJson, Error, TEXT("Expected a string, got %s."), *TypeToString(value));
-			return "";
-		}
-
-		return TransCode<FString, rapidjson::UTF16<>, rapidjson::UTF8<>>(value);
+		FString result;
+		AssignString(value.GetString(), value.GetStringLength(), result);
+		return result;
 	}
 };
 
+/** Names are looked up in the name cache straight from the document's characters. */
 template <> struct ValueExtractor<FName>
 {
     template <typename EncodingType, typename AllocatorType>
-    static auto ExtractOrThrow(const rapidjson::GenericValue<EncodingType, AllocatorType>& value)
-        -> typename TEnableIf<
-        TIsSame<typename EncodingType::Ch, ANSICHAR>::Value, FName>::Type
-    {
-        if (!value.IsString())
-        {
-            UE_LOG(LogRapidJson, Error, TEXT("Expected a string, got %s."), *TypeToString(value));
-            return FString::Empty;
-        }
-
-        return TCHAR_TO_UTF8(value.GetString());
-    }
-
-    template <typename EncodingType, typename AllocatorType>
-    static auto ExtractOrThrow(const rapidjson::GenericValue<EncodingType, AllocatorType>& value)
-        -> typename TEnableIf<
-        TIsSame<typename EncodingType::Ch, TCHAR>::Value, FName>::Type
+    static FName ExtractOrThrow(const rapidjson::GenericValue<EncodingType, AllocatorType>& value)
     {
         if (!value.IsString())
         {
             UE_LOG(LogRapidJson, Error, TEXT("Expected a string, got %s."), *TypeToString(value));
-            return "";
+            return NAME_None;
         }
 
-        return TransCode<FName, rapidjson::UTF16<>, rapidjson::UTF8<>>(value);
+        return FNameCache::FindOrAdd(value.GetString(), static_cast<int32>(value.GetStringLength()));
     }
 };
 
@@ -386,72 +481,131 @@ template <typename DataType> struct ValueExtractor<TOptional<DataType>>
 	}
 };
 
-template <typename InsertionPolicy, typename DataType, typename ContainerType>
-void Insert(DataType&& value, ContainerType& container)
+/**
+ * Decodes object member names into map keys. `Assign` overwrites an existing key and returns false,
+ * after logging, for a name that does not spell a key; decoding every member of an object into the
+ * same key lets a string key reuse its buffer.
+ **/
+template <typename KeyType, typename = void> struct KeyExtractor
 {
-	static_assert(
-		TIsConstructible<DataType, typename ContainerType::ElementType>::Value,
-		"The type being inserted is not the same as, or cannot be converted to, the "
-		"container's value type.");
+	static KeyType Default()
+	{
+		return KeyType();
+	}
 
-	InsertionPolicy::Insert(MoveTemp(value), container);
-}
+	template <typename EncodingType, typename AllocatorType>
+	static bool Assign(const rapidjson::GenericValue<EncodingType, AllocatorType>& name, KeyType& key)
+	{
+		key = ValueExtractor<KeyType>::ExtractOrThrow(name);
+		return true;
+	}
+};
 
-template <typename PairType, typename EncodingType, typename AllocatorType>
-PairType ConstructNestedPair(const rapidjson::GenericMember<EncodingType, AllocatorType>& member)
+template <> struct KeyExtractor<FString>
 {
-	using KeyType = typename TDecay<typename PairType::KeyType>::Type;
-	using NestedType = typename PairType::ValueType;
+	static FString Default()
+	{
+		return FString();
+	}
 
-	static_assert(
-		TIsConstructible<NestedType>::Value,
-		"Nested container must be default constructible.");
+	template <typename EncodingType, typename AllocatorType>
+	static bool Assign(const rapidjson::GenericValue<EncodingType, AllocatorType>& name, FString& key)
+	{
+		AssignString(name.GetString(), name.GetStringLength(), key);
+		return true;
+	}
+};
 
-	NestedType container;
-	Deserializer::FromJson(member.value, container);
+/** Parses the decimal text of an integer key, rejecting signs, digits or magnitudes it cannot hold. */
+template <typename KeyType, typename CharacterType>
+bool ParseIntegerKey(const CharacterType* const text, const rapidjson::SizeType length, KeyType& key)
+{
+	const bool negative = length > 0 && text[0] == '-';
+	if (negative && !TIsSigned<KeyType>::Value)
+	{
+		return false;
+	}
 
-	return MakeTuple(ValueExtractor<KeyType>::ExtractOrThrow(member.name), MoveTemp(container));
-}
+	rapidjson::SizeType index = negative ? 1 : 0;
+	if (index == length)
+	{
+		return false;
+	}
 
-template <typename PairType, typename EncodingType, typename AllocatorType>
-auto ToKeyValuePair(const rapidjson::GenericMember<EncodingType, AllocatorType>& member) ->
-typename TEnableIf<
-	Traits::TreatAsValue<typename PairType::ValueType>::Value, PairType>::Type
-{
-	using KeyType = typename TDecay<typename PairType::KeyType>::Type;
-	using ValueType = typename PairType::ValueType;
+	// The magnitude of a signed minimum is one more than that of its maximum.
+	const uint64 limit = static_cast<uint64>(TNumericLimits<KeyType>::Max()) + (negative ? 1 : 0);
+	uint64 magnitude = 0;
+	for (; index < length; ++index)
+	{
+		if (text[index] < '0' || text[index] > '9')
+		{
+			return false;
+		}
 
-	return MakeTuple(ValueExtractor<KeyType>::ExtractOrThrow(member.name),
-		ValueExtractor<ValueType>::ExtractOrThrow(member.value));
-}
+		const uint64 digit = static_cast<uint64>(text[index] - '0');
+		if (magnitude > (limit - digit) / 10)
+		{
+			return false;
+		}
 
+		magnitude = magnitude * 10 + digit;
+	}
+
+	key = negative ? static_cast<KeyType>(-static_cast<int64>(magnitude - 1) - 1)
+		: static_cast<KeyType>(magnitude);
+	return true;
+}
 
-template <typename PairType, typename EncodingType, typename AllocatorType>
-auto ToKeyValuePair(const rapidjson::GenericMember<EncodingType, AllocatorType>& member) ->
-typename TEnableIf<
-	Traits::TreatAsObject<typename PairType::ValueType>::Value, PairType>::Type
+template <typename KeyType>
+struct KeyExtractor<
+	KeyType, typename TEnableIf<TIsIntegral<KeyType>::Value && !TIsSame<KeyType, bool>::Value>::Type>
 {
-	if (!member.value.IsObject())
+	static KeyType Default()
 	{
-		UE_LOG(LogRapidJson, Error, TEXT("Expected an object, got %s."), *TypeToString(member.value));
-		return;
+		return 0;
 	}
 
-	return ConstructNestedPair<PairType>(member);
-}
+	template <typename EncodingType, typename AllocatorType>
+	static bool Assign(const rapidjson::GenericValue<EncodingType, AllocatorType>& name, KeyType& key)
+	{
+		if (ParseIntegerKey(name.GetString(), name.GetStringLength(), key))
+		{
+			return true;
+		}
 
-template <typename PairType, typename EncodingType, typename AllocatorType>
-auto ToKeyValuePair(const rapidjson::GenericMember<EncodingType, AllocatorType>& member) ->
-typename TEnableIf<
-	Traits::TreatAsArray<typename PairType::ValueType>::Value, PairType>::Type
+		FString text;
+		AssignString(name.GetString(), name.GetStringLength(), text);
+		UE_LOG(LogRapidJson, Error, TEXT("Expected an integer key, got \"%s\"."), *text);
+		return false;
+	}
+};
+
+/** `JSON_MAKE_ENUM` keys are looked up like values, so an unknown name throws. */
+template <typename KeyType>
+struct KeyExtractor<KeyType, typename TEnableIf<Traits::IsBetterEnum<KeyType>::Value>::Type>
 {
-	if (!member.value.IsArray())
+	static KeyType Default()
 	{
-		UE_LOG(LogRapidJson, Error, TEXT("Expected an array, got %s."), *TypeToString(member.value));
-		return;
+		return KeyType::_from_index_unchecked(0);
 	}
 
-	return ConstructNestedPair<PairType>(member);
+	template <typename EncodingType, typename AllocatorType>
+	static bool Assign(const rapidjson::GenericValue<EncodingType, AllocatorType>& name, KeyType& key)
+	{
+		key = EnumFromString<KeyType>(name);
+		return true;
+	}
+};
+
+template <typename InsertionPolicy, typename DataType, typename ContainerType>
+void Insert(DataType&& value, ContainerType& container)
+{
+	static_assert(
+		TIsConstructible<DataType, typename ContainerType::ElementType>::Value,
+		"The type being inserted is not the same as, or cannot be converted to, the "
+		"container's value type.");
+
+	InsertionPolicy::Insert(MoveTemp(value), container);
 }
 
 template <
@@ -459,8 +613,16 @@ template <
 	void DispatchInsertion(
 		const rapidjson::GenericMember<EncodingType, AllocatorType>& member, ContainerType& container)
 {
-	auto pair = ToKeyValuePair<typename ContainerType::ElementType>(member);
-	Insert<InsertionPolicy>(MoveTemp(pair), container);
+	using KeyType = typename Traits::PairTypes<typename ContainerType::ElementType>::KeyType;
+
+	KeyType key = KeyExtractor<KeyType>::Default();
+	if (!KeyExtractor<KeyType>::Assign(member.name, key))
+	{
+		return;
+	}
+
+	auto&& value = InsertionPolicy::Emplace(MoveTemp(key), container);
+	Deserializer::FromJson(member.value, value);
 }
 
 template <
@@ -508,6 +670,8 @@ template <
 	}
 
 	const auto& json_object = json_value.GetObject();
+	InsertionPolicy::Prepare(container, static_cast<int32>(json_object.MemberCount()));
+
 	for (const auto& nested_json_value : json_object)
 	{
 		DispatchInsertion<InsertionPolicy>(nested_json_value, container);
@@ -526,6 +690,8 @@ template <
 	}
 
 	const auto& json_array = json_value.GetArray();
+	InsertionPolicy::Prepare(container, static_cast<int32>(json_array.Size()));
+
 	for (const auto& nested_json_value : json_array)
 	{
 		DispatchInsertion<InsertionPolicy>(nested_json_value, container);
@@ -551,6 +717,154 @@ auto FromJson(
 	DeserializeJsonObject<BackInsertionPolicy>(json_value, container);
 }
 
+/**
+ * Overwrites the array in place: existing elements are decoded into directly and the array only
+ * grows or shrinks at its tail, without releasing its allocation.
+ **/
+template <
+	typename ElementType, typename ArrayAllocatorType, typename EncodingType, typename AllocatorType>
+auto FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TArray<ElementType, ArrayAllocatorType>& container) ->
+	typename TEnableIf<
+	Traits::TreatAsArray<TArray<ElementType, ArrayAllocatorType>>::Value>::Type
+{
+	if (!json_value.IsArray())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Expected an array, got %s."), *TypeToString(json_value));
+		return;
+	}
+
+	const auto& json_array = json_value.GetArray();
+	container.SetNum(static_cast<int32>(json_array.Size()), false);
+
+	int32 index = 0;
+	for (const auto& nested_json_value : json_array)
+	{
+		Deserializer::FromJson(nested_json_value, container[index++]);
+	}
+}
+
+/**
+ * Decodes into storage whose size cannot change. Surplus JSON elements are reported and dropped,
+ * and elements the document does not provide are reset to their default value.
+ **/
+template <typename ElementType, typename EncodingType, typename AllocatorType>
+void DeserializeFixedSizeArray(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, ElementType* elements,
+	const int32 capacity)
+{
+	if (!json_value.IsArray())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Expected an array, got %s."), *TypeToString(json_value));
+		return;
+	}
+
+	const auto& json_array = json_value.GetArray();
+	const int32 count = static_cast<int32>(json_array.Size());
+	if (count > capacity)
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Expected at most %d elements, got %d."), capacity, count);
+	}
+
+	const int32 decoded_count = FMath::Min(count, capacity);
+	for (int32 index = 0; index < decoded_count; ++index)
+	{
+		Deserializer::FromJson(json_array[index], elements[index]);
+	}
+
+	for (int32 index = decoded_count; index < capacity; ++index)
+	{
+		elements[index] = ElementType();
+	}
+}
+
+template <
+	typename ElementType, uint32 ArraySize, uint32 Alignment, typename EncodingType,
+	typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TStaticArray<ElementType, ArraySize, Alignment>& container)
+{
+	DeserializeFixedSizeArray(json_value, &container[0], static_cast<int32>(ArraySize));
+}
+
+template <typename ElementType, size_t ArraySize, typename EncodingType, typename AllocatorType>
+auto FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	ElementType (&container)[ArraySize]) ->
+	typename TEnableIf<Traits::TreatAsArray<ElementType[ArraySize]>::Value>::Type
+{
+	DeserializeFixedSizeArray(json_value, container, static_cast<int32>(ArraySize));
+}
+
+/**
+ * Updates the map in place: values whose key is still present are decoded into their existing
+ * node, new keys are added and keys missing from the document are removed.
+ *
+ * @note Every member name is decoded into the same key, which is only copied into the map when it
+ * is new. Decoding a document with the keys the map already holds thus allocates no key at all.
+ **/
+template <
+	typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType,
+	typename EncodingType, typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& container)
+{
+	if (!json_value.IsObject())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Expected an object, got %s."), *TypeToString(json_value));
+		return;
+	}
+
+	const auto& json_object = json_value.GetObject();
+	const bool had_entries = container.Num() > 0;
+	container.Reserve(static_cast<int32>(json_object.MemberCount()));
+
+	KeyType key = KeyExtractor<KeyType>::Default();
+	TBitArray<> decoded_members{ false, static_cast<int32>(json_object.MemberCount()) };
+	int32 decoded_count = 0;
+	int32 member_index = 0;
+	for (const auto& member : json_object)
+	{
+		if (KeyExtractor<KeyType>::Assign(member.name, key))
+		{
+			Deserializer::FromJson(member.value, container.FindOrAdd(static_cast<const KeyType&>(key)));
+			decoded_members[member_index] = true;
+			++decoded_count;
+		}
+		++member_index;
+	}
+
+	if (!had_entries)
+	{
+		return;
+	}
+
+	// Counting is not enough, as a key repeated in the document would hide a stale entry. Nothing is
+	// added past this point, so the written entries are told apart by the address of their value.
+	TSet<const ValueType*> written_values;
+	written_values.Reserve(decoded_count);
+	member_index = 0;
+	for (const auto& member : json_object)
+	{
+		if (decoded_members[member_index++])
+		{
+			KeyExtractor<KeyType>::Assign(member.name, key);
+			written_values.Add(container.Find(static_cast<const KeyType&>(key)));
+		}
+	}
+
+	for (auto iterator = container.CreateIterator(); iterator; ++iterator)
+	{
+		if (!written_values.Contains(&iterator.Value()))
+		{
+			iterator.RemoveCurrent();
+		}
+	}
+}
+
 template <typename DataType, typename EncodingType, typename AllocatorType>
 auto FromJson(
 	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, DataType& data) ->
@@ -585,17 +899,30 @@ template <typename DataType, typename EncodingType, typename AllocatorType>
 auto FromJson(
 	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, DataType& data) ->
 	typename TEnableIf<
-	Traits::TreatAsValue<typename DataType>::Value &&
+	Traits::TreatAsValue<DataType>::Value &&
 	!Traits::HasFromJson<DataType, EncodingType, AllocatorType>::Value>::Type
 {
 	data = ValueExtractor<DataType>::ExtractOrThrow(json_value);
 }
 
+template <typename EncodingType, typename AllocatorType>
+void FromJson(const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, FString& data)
+{
+	if (!json_value.IsString())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Expected a string, got %s."), *TypeToString(json_value));
+		data.Reset();
+		return;
+	}
+
+	AssignString(json_value.GetString(), json_value.GetStringLength(), data);
+}
+
 template <typename DataType, typename EncodingType, typename AllocatorType>
 auto FromJson(
 	const rapidjson::GenericMember<EncodingType, AllocatorType>& member, DataType& data) ->
 	typename TEnableIf<
-	Traits::TreatAsValue<typename DataType>::Value &&
+	Traits::TreatAsValue<DataType>::Value &&
 	!Traits::HasFromJson<DataType, EncodingType, AllocatorType>::Value>::Type
 {
 	data = ValueExtractor<DataType>::ExtractOrThrow(member.value);
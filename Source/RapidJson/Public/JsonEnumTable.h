@@ -0,0 +1,188 @@
+#pragma once
+
+#include <rapidjson/rapidjson.h>
+#include "CoreMinimal.h"
+
+namespace Json
+{
+namespace Detail
+{
+/**
+ * Name and value lookup for a `JSON_MAKE_ENUM` type, built once on first use.
+ *
+ * Names are kept in an open addressing table at most half full, probed linearly from the hash of
+ * the name. Decoding a name hashes the document's characters as they are and compares them
+ * against the names met along the probe, whatever the encoding and without converting the string
+ * first; at that load a lookup visits two slots on average. Each enumerator is also kept as a
+ * ready-to-write `"Name"` token, found from its value without searching when the values are dense.
+ *
+ * @note better_enums only trims its names at run time, so the table cannot be built at compile
+ * time; building it hashes each name once, once per type.
+ **/
+template <typename EnumType> class TEnumNameTable
+{
+public:
+	static const TEnumNameTable& Get()
+	{
+		static const TEnumNameTable table;
+		return table;
+	}
+
+	/** Returns the index of the enumerator named by `length` code units of `name`, if any. */
+	template <typename CharacterType>
+	int32 Find(const CharacterType* const name, const rapidjson::SizeType length) const
+	{
+		for (uint32 slot = Hash(name, length) & Mask;; slot = (slot + 1) & Mask)
+		{
+			const int32 index = static_cast<int32>(Slots[slot]) - 1;
+			if (index == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+
+			if (NameEquals(Tokens[index], name, length))
+			{
+				return index;
+			}
+		}
+	}
+
+	/** Returns the name of `value` in double quotes. It needs no escaping, being an identifier. */
+	const TArray<ANSICHAR>& GetToken(const EnumType value) const
+	{
+		const int64 integral = static_cast<int64>(value._to_integral());
+		if (DenseIndices.Num() > 0)
+		{
+			return Tokens[DenseIndices[static_cast<int32>(integral - MinValue)]];
+		}
+
+		return Tokens[SparseIndices.FindChecked(integral)];
+	}
+
+private:
+	TEnumNameTable()
+	{
+		const auto names = EnumType::_names();
+		for (const ANSICHAR* const name : names)
+		{
+			TArray<ANSICHAR>& token = Tokens.AddDefaulted_GetRef();
+			token.Add('"');
+			token.Append(name, FCStringAnsi::Strlen(name));
+			token.Add('"');
+		}
+
+		BuildNameSlots();
+		BuildValueIndices();
+	}
+
+	/** Values spread over more than this many slots per enumerator are looked up in a map. */
+	static constexpr uint64 MaxDenseSpread = 4;
+
+	/** FNV-1a over code units; names are ASCII, so UTF-8 and UTF-16 text hash alike. */
+	template <typename CharacterType>
+	static uint32 Hash(const CharacterType* const name, const rapidjson::SizeType length)
+	{
+		uint32 hash = 2166136261u;
+		for (rapidjson::SizeType index = 0; index < length; ++index)
+		{
+			hash = (hash ^ static_cast<uint32>(name[index])) * 16777619u;
+		}
+
+		return hash ^ (hash >> 15);
+	}
+
+	template <typename CharacterType>
+	static bool NameEquals(
+		const TArray<ANSICHAR>& token, const CharacterType* const name, const rapidjson::SizeType length)
+	{
+		if (static_cast<rapidjson::SizeType>(token.Num() - 2) != length)
+		{
+			return false;
+		}
+
+		for (rapidjson::SizeType offset = 0; offset < length; ++offset)
+		{
+			if (static_cast<CharacterType>(token[offset + 1]) != name[offset])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void BuildNameSlots()
+	{
+		uint32 size = 4;
+		while (size < static_cast<uint32>(Tokens.Num()) * 2)
+		{
+			size *= 2;
+		}
+
+		Mask = size - 1;
+		Slots.AddZeroed(static_cast<int32>(size));
+
+		for (int32 index = 0; index < Tokens.Num(); ++index)
+		{
+			const rapidjson::SizeType length = static_cast<rapidjson::SizeType>(Tokens[index].Num() - 2);
+			uint32 slot = Hash(Tokens[index].GetData() + 1, length) & Mask;
+			while (Slots[slot] != 0)
+			{
+				slot = (slot + 1) & Mask;
+			}
+
+			Slots[slot] = static_cast<uint16>(index + 1);
+		}
+	}
+
+	/** Aliased values keep the first enumerator, as `_to_index()` does. */
+	void BuildValueIndices()
+	{
+		const auto values = EnumType::_values();
+		const int32 count = static_cast<int32>(values.size());
+		if (count == 0)
+		{
+			return;
+		}
+
+		MinValue = static_cast<int64>(values[0]._to_integral());
+		int64 max_value = MinValue;
+		for (int32 index = 1; index < count; ++index)
+		{
+			MinValue = FMath::Min(MinValue, static_cast<int64>(values[index]._to_integral()));
+			max_value = FMath::Max(max_value, static_cast<int64>(values[index]._to_integral()));
+		}
+
+		const uint64 spread = static_cast<uint64>(max_value) - static_cast<uint64>(MinValue);
+		const bool dense = spread < static_cast<uint64>(count) * MaxDenseSpread;
+		if (dense)
+		{
+			DenseIndices.Init(INDEX_NONE, static_cast<int32>(spread) + 1);
+		}
+
+		for (int32 index = 0; index < count; ++index)
+		{
+			const int64 integral = static_cast<int64>(values[index]._to_integral());
+			if (dense)
+			{
+				int32& slot = DenseIndices[static_cast<int32>(integral - MinValue)];
+				slot = slot == INDEX_NONE ? index : slot;
+			}
+			else if (!SparseIndices.Contains(integral))
+			{
+				SparseIndices.Add(integral, index);
+			}
+		}
+	}
+
+	TArray<TArray<ANSICHAR>> Tokens;
+	/** One-based index of the enumerator in each slot, 0 for an empty slot. */
+	TArray<uint16> Slots;
+	uint32 Mask = 0;
+	/** Index of the enumerator of each value from `MinValue` on, when the values are dense. */
+	TArray<int32> DenseIndices;
+	TMap<int64, int32> SparseIndices;
+	int64 MinValue = 0;
+};
+} // namespace Detail
+} // namespace Json
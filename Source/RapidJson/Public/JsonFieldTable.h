@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonDeserializer.h"
+#include "JsonFields.h"
+#include "JsonSerializer.h"
+
+namespace Json
+{
+namespace Detail
+{
+/**
+ * One field of a `JSON_DEFINE` or `JSON_EXTERNAL_DEFINE` type, with its type erased: the name, the
+ * offset of the member within the object and the codec that reads or writes it.
+ *
+ * @note Codecs depend only on the field's type and the writer or document type, so every type with
+ * e.g. a `float` field shares the same one, instead of each instantiating its own read/write code.
+ **/
+template <typename CodecType> struct TFieldDescriptor
+{
+	const ANSICHAR* Name;
+	rapidjson::SizeType NameLength;
+	SIZE_T Offset;
+	CodecType* Codec;
+};
+
+/** Field codecs for serializing with `WriterType`. */
+template <typename WriterType> struct TFieldWriter
+{
+	using CodecType = void(WriterType&, const void*);
+
+	template <typename FieldType> static void Write(WriterType& writer, const void* const field)
+	{
+		Serializer::ToJson(writer, *static_cast<const FieldType*>(field));
+	}
+
+	template <typename FieldType> static CodecType* GetCodec()
+	{
+		return &Write<FieldType>;
+	}
+};
+
+/** Field codecs for deserializing from documents of `EncodingType` and `AllocatorType`. */
+template <typename EncodingType, typename AllocatorType> struct TFieldReader
+{
+	using CodecType = void(const rapidjson::GenericValue<EncodingType, AllocatorType>&, void*);
+
+	template <typename FieldType>
+	static void Read(const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, void* const field)
+	{
+		Deserializer::FromJson(json_value, *static_cast<FieldType*>(field));
+	}
+
+	template <typename FieldType> static CodecType* GetCodec()
+	{
+		return &Read<FieldType>;
+	}
+};
+
+/**
+ * Returns the field table of `DataType` for the codecs of `CodecsType`, building it on first use.
+ * Offsets are measured on `data`, so the table holds for every object of the type.
+ **/
+template <typename CodecsType, typename DataType>
+const TArray<TFieldDescriptor<typename CodecsType::CodecType>>& GetFieldTable(const DataType& data)
+{
+	static const TArray<TFieldDescriptor<typename CodecsType::CodecType>> fields = [&data]() {
+		TArray<TFieldDescriptor<typename CodecsType::CodecType>> table;
+		VisitFields(data, [&](const ANSICHAR* const name, auto member) {
+			using FieldType = typename TDecay<decltype(data.*member)>::Type;
+			const SIZE_T offset =
+				reinterpret_cast<const uint8*>(&(data.*member)) - reinterpret_cast<const uint8*>(&data);
+			table.Add({ name, static_cast<rapidjson::SizeType>(FCStringAnsi::Strlen(name)), offset,
+				CodecsType::template GetCodec<FieldType>() });
+		});
+		return table;
+	}();
+
+	return fields;
+}
+
+/** Writes `object` as a JSON object, one member per entry of its field table. */
+template <typename WriterType>
+void WriteFieldTable(
+	WriterType& writer, const void* const object,
+	const TArray<TFieldDescriptor<typename TFieldWriter<WriterType>::CodecType>>& fields)
+{
+	writer.StartObject();
+
+	for (const auto& field : fields)
+	{
+		writer.Key(field.Name, field.NameLength);
+		field.Codec(writer, static_cast<const uint8*>(object) + field.Offset);
+	}
+
+	writer.EndObject();
+}
+
+/**
+ * Reads every field of `object` from `json_value`. Stops at the first missing member, leaving the
+ * remaining fields untouched.
+ *
+ * @note Documents written from the same definition list their members in field order, so each
+ * field is first looked for right after the previous one, and only searched for when it is not
+ * there.
+ **/
+template <typename EncodingType, typename AllocatorType>
+void ReadFieldTable(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, void* const object,
+	const TArray<TFieldDescriptor<typename TFieldReader<EncodingType, AllocatorType>::CodecType>>& fields)
+{
+	if (!json_value.IsObject())
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Expected an object, got %s."),
+			*Deserializer::Detail::TypeToString(json_value));
+		return;
+	}
+
+	auto next_member = json_value.MemberBegin();
+	for (const auto& field : fields)
+	{
+		auto member = next_member;
+		JSON_UTILS_STAT_ADD(MemberCompares, member != json_value.MemberEnd());
+		if (member == json_value.MemberEnd() || member->name.GetStringLength() != field.NameLength ||
+			!FieldNameEquals(member->name.GetString(), field.NameLength, field.Name))
+		{
+			member = FindField(json_value, field.Name);
+			if (member == json_value.MemberEnd())
+			{
+				UE_LOG(LogRapidJson, Error, TEXT("not found member %s"), UTF8_TO_TCHAR(field.Name));
+				return;
+			}
+		}
+
+		field.Codec(member->value, static_cast<uint8*>(object) + field.Offset);
+		next_member = member + 1;
+	}
+}
+
+/** Serializes a `JSON_DEFINE` or `JSON_EXTERNAL_DEFINE` type through its field table. */
+template <typename WriterType, typename DataType>
+void WriteFields(WriterType& writer, const DataType& data)
+{
+	WriteFieldTable(writer, &data, GetFieldTable<TFieldWriter<WriterType>>(data));
+}
+
+template <typename EncodingType, typename AllocatorType, typename DataType>
+void ReadFields(const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, DataType& data)
+{
+	ReadFieldTable(json_value, &data, GetFieldTable<TFieldReader<EncodingType, AllocatorType>>(data));
+}
+} // namespace Detail
+} // namespace Json
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <rapidjson/document.h>
+#include "CoreMinimal.h"
+#include "JsonStats.h"
+#include "JsonTraits.h"
+
+namespace Json
+{
+namespace Detail
+{
+/**
+ * Calls `visitor(name, member_pointer)` for every field listed in the type's `JSON_DEFINE` or
+ * `JSON_EXTERNAL_DEFINE`, in declaration order. The member pointers can be applied to any
+ * instance of the type, which lets a single visit compare or combine several objects.
+ **/
+template <typename DataType, typename VisitorType>
+auto VisitFields(const DataType& data, VisitorType&& visitor) ->
+	typename TEnableIf<Traits::HasMemberJsonFields<DataType>::Value>::Type
+{
+	data.VisitJsonFields(visitor);
+}
+
+template <typename DataType, typename VisitorType>
+auto VisitFields(const DataType& data, VisitorType&& visitor) ->
+	typename TEnableIf<
+	!Traits::HasMemberJsonFields<DataType>::Value &&
+	Traits::HasExternalJsonFields<DataType>::Value>::Type
+{
+	VisitJsonFields(data, visitor);
+}
+
+/** Compares a JSON member name against an ASCII field name without converting either. */
+template <typename CharacterType>
+bool FieldNameEquals(
+	const CharacterType* name, const rapidjson::SizeType length, const ANSICHAR* field_name)
+{
+	for (rapidjson::SizeType index = 0; index < length; ++index)
+	{
+		if (field_name[index] == '\0' || static_cast<CharacterType>(field_name[index]) != name[index])
+		{
+			return false;
+		}
+	}
+
+	return field_name[length] == '\0';
+}
+
+/** Finds a field's member by its ASCII name, whatever the encoding of the document. */
+template <typename EncodingType, typename AllocatorType>
+typename rapidjson::GenericValue<EncodingType, AllocatorType>::ConstMemberIterator FindField(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& object, const ANSICHAR* field_name)
+{
+	JSON_UTILS_STAT_ADD(MemberLookups, 1);
+
+	auto member = object.MemberBegin();
+	for (; member != object.MemberEnd(); ++member)
+	{
+		JSON_UTILS_STAT_ADD(MemberCompares, 1);
+		if (FieldNameEquals(member->name.GetString(), member->name.GetStringLength(), field_name))
+		{
+			break;
+		}
+	}
+
+	return member;
+}
+} // namespace Detail
+} // namespace Json
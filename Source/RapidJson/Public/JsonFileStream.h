@@ -0,0 +1,278 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/Archive.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+/**
+ * rapidjson output stream that writes UTF-8 text to a file from the thread pool.
+ *
+ * Text goes into one of two buffers; when it fills up, the buffer is handed to a background task
+ * that writes it to disk while serialization carries on in the other one. The serializing thread
+ * only waits when it fills a buffer before the disk has taken the previous one.
+ *
+ * @note Call `Close` once the document is complete, to wait for the last write and learn whether
+ * the file was written; the destructor does it otherwise.
+ **/
+class RAPIDJSON_API FAsyncFileOutputStream
+{
+public:
+	typedef ANSICHAR Ch;
+
+	static constexpr int32 DefaultBufferSize = 256 * 1024;
+
+	explicit FAsyncFileOutputStream(const TCHAR* path, int32 buffer_size = DefaultBufferSize);
+	~FAsyncFileOutputStream();
+
+	FAsyncFileOutputStream(const FAsyncFileOutputStream&) = delete;
+	FAsyncFileOutputStream& operator=(const FAsyncFileOutputStream&) = delete;
+
+	bool IsOpen() const
+	{
+		return Archive.IsValid();
+	}
+
+	void Put(const Ch character)
+	{
+		*Cursor++ = character;
+		if (Cursor == BufferEnd)
+		{
+			Submit();
+		}
+	}
+
+	/** Writers flush after every top-level value; the buffer is written once it is full instead. */
+	void Flush()
+	{
+	}
+
+	/** Writes the remaining text, waits for the disk and closes the file. Returns false on error. */
+	bool Close();
+
+	/** Number of bytes of text put into the stream so far. */
+	size_t GetWrittenSize() const
+	{
+		return Written + (Cursor - Buffers[ActiveBuffer].GetData());
+	}
+
+	// Not implemented, as in rapidjson's own output streams.
+	Ch Peek() const
+	{
+		check(false);
+		return 0;
+	}
+
+	Ch Take()
+	{
+		check(false);
+		return 0;
+	}
+
+	size_t Tell() const
+	{
+		check(false);
+		return 0;
+	}
+
+	Ch* PutBegin()
+	{
+		check(false);
+		return nullptr;
+	}
+
+	size_t PutEnd(Ch*)
+	{
+		check(false);
+		return 0;
+	}
+
+private:
+	/** Hands the active buffer to the background writer and switches to the other one. */
+	void Submit();
+
+	/** Waits for the write in flight, if any. */
+	void WaitForWrite();
+
+	TUniquePtr<FArchive> Archive;
+	TArray<Ch> Buffers[2];
+	int32 ActiveBuffer = 0;
+	Ch* Cursor = nullptr;
+	Ch* BufferEnd = nullptr;
+	/** Bytes of text handed to the background writer, whether or not they reached the disk. */
+	size_t Written = 0;
+	TFuture<bool> PendingWrite;
+	bool Failed = false;
+};
+
+/**
+ * rapidjson input stream that reads a UTF-8 file ahead of the parser on the thread pool.
+ *
+ * The file is read into a ring of buffers. While the parser works through one buffer, the reads
+ * for the following ones are already in flight, and a buffer is queued for the next part of the
+ * file as soon as the parser leaves it. Parsing only waits when it catches up with the disk.
+ *
+ * @note Read errors end the text early, which the parser reports as a parse error.
+ **/
+class RAPIDJSON_API FReadAheadFileInputStream
+{
+public:
+	typedef ANSICHAR Ch;
+
+	static constexpr int32 DefaultBufferSize = 256 * 1024;
+	static constexpr int32 DefaultBufferCount = 4;
+
+	explicit FReadAheadFileInputStream(
+		const TCHAR* path, int32 buffer_size = DefaultBufferSize,
+		int32 buffer_count = DefaultBufferCount);
+	~FReadAheadFileInputStream();
+
+	FReadAheadFileInputStream(const FReadAheadFileInputStream&) = delete;
+	FReadAheadFileInputStream& operator=(const FReadAheadFileInputStream&) = delete;
+
+	bool IsOpen() const
+	{
+		return Archive.IsValid();
+	}
+
+	Ch Peek() const
+	{
+		return *Current;
+	}
+
+	Ch Take()
+	{
+		const Ch character = *Current;
+		if (Current + 1 < BufferEnd)
+		{
+			++Current;
+		}
+		else if (!Ended)
+		{
+			NextBuffer();
+		}
+
+		return character;
+	}
+
+	size_t Tell() const
+	{
+		return Consumed + (Current - BufferBegin);
+	}
+
+	/** Whether the file could not be read, as opposed to holding malformed JSON. */
+	bool HasError() const
+	{
+		return Failed;
+	}
+
+	// Not implemented, as in rapidjson's own input streams.
+	void Put(Ch)
+	{
+		check(false);
+	}
+
+	void Flush()
+	{
+		check(false);
+	}
+
+	Ch* PutBegin()
+	{
+		check(false);
+		return nullptr;
+	}
+
+	size_t PutEnd(Ch*)
+	{
+		check(false);
+		return 0;
+	}
+
+private:
+	struct FBuffer
+	{
+		TArray<Ch> Text;
+		/** Number of bytes read into `Text`, or -1 on error. Invalid once the file is exhausted. */
+		TFuture<int32> Read;
+	};
+
+	/** Queues a read of the next part of the file into `Buffers[index]`. */
+	void RequestRead(int32 index);
+
+	/** Recycles the current buffer and moves on to the next one, waiting for it if needed. */
+	void NextBuffer();
+
+	/** Waits for `Buffers[index]` and makes it current. */
+	void UseBuffer(int32 index);
+
+	TUniquePtr<FArchive> Archive;
+	/** Reads are positioned explicitly, but the archive itself is not thread-safe. */
+	FCriticalSection ArchiveMutex;
+	TArray<FBuffer> Buffers;
+	int64 FileSize = 0;
+	int64 NextReadOffset = 0;
+	int32 ActiveBuffer = 0;
+
+	const Ch* BufferBegin = nullptr;
+	const Ch* Current = nullptr;
+	const Ch* BufferEnd = nullptr;
+	size_t Consumed = 0;
+	bool Ended = false;
+	bool Failed = false;
+};
+
+/**
+ * Serializes `data` as UTF-8 JSON into the file at `path`, overlapping the disk writes with
+ * serialization. Returns false if the file could not be written.
+ **/
+template <typename InputEncodingType = rapidjson::UTF8<>, typename DataType>
+bool SerializeToFile(const FString& path, const DataType& data)
+{
+	FAsyncFileOutputStream stream{ *path };
+	if (!stream.IsOpen())
+	{
+		return false;
+	}
+
+	JSON_UTILS_ENCODE_SCOPE();
+
+	rapidjson::Writer<FAsyncFileOutputStream, InputEncodingType, rapidjson::UTF8<>, FCrtAllocator> writer{
+		stream
+	};
+	Serializer::ToJson(writer, data);
+	JSON_UTILS_STAT_ADD(EncodedDocuments, 1);
+	JSON_UTILS_STAT_ADD(EncodedBytes, stream.GetWrittenSize());
+
+	return stream.Close();
+}
+
+/** Decodes the UTF-8 JSON file at `path` into an existing object, reading ahead while parsing. */
+template <typename DataType>
+void DeserializeFromFile(const FString& path, DataType& data)
+{
+	FReadAheadFileInputStream stream{ *path };
+	if (!stream.IsOpen())
+	{
+		throw std::invalid_argument(TCHAR_TO_UTF8(*FString::Printf(TEXT("Could not open %s."), *path)));
+	}
+
+	Detail::DeserializeInto<DataType, rapidjson::UTF8<>>(stream, data);
+}
+
+template <typename ContainerType>
+JSON_UTILS_NODISCARD ContainerType DeserializeFromFile(const FString& path)
+{
+	static_assert(
+		TIsConstructible<ContainerType>::Value,
+		"The container must have a default constructible.");
+
+	ContainerType container;
+	DeserializeFromFile(path, container);
+
+	return container;
+}
+} // namespace Json
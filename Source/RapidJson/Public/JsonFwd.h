@@ -6,6 +6,10 @@
 
 namespace Json
 {
+template <typename DataType> class TMemoized;
+template <typename ElementType> class TColumnar;
+template <typename ElementType> class TBase64Array;
+
 namespace Serializer
 {
 namespace Detail
@@ -28,6 +32,8 @@ template <typename WriterType, typename CharacterType>
 void ToJson(
 	WriterType& writer, const FString& data);
 
+template <typename WriterType> void ToJson(WriterType& writer, const FName& data);
+
 template <typename WriterType> auto ToJson(WriterType& writer, const ANSICHAR* data);
 
 template <typename WriterType> auto ToJson(WriterType& writer, const TCHAR* data);
@@ -41,6 +47,12 @@ void ToJson(WriterType& writer, const TUniquePtr<DataType>& pointer);
 template <typename WriterType, typename DataType>
 void ToJson(WriterType& writer, const TWeakPtr<DataType>& weakPointer);
 
+template <typename WriterType, typename ElementType, typename AllocatorType>
+auto ToJson(WriterType& writer, const TArray<ElementType, AllocatorType>& container) ->
+typename TEnableIf<
+	Traits::WriterTraits<WriterType>::Value && TIsIntegral<ElementType>::Value &&
+	!TIsSame<ElementType, bool>::Value>::Type;
+
 template <typename WriterType, typename ContainerType>
 auto ToJson(WriterType& writer, const ContainerType& container) ->
 typename TEnableIf<Traits::TreatAsArray<ContainerType>::Value>::Type;
@@ -80,6 +92,34 @@ auto FromJson(
 	typename TEnableIf<
 	Traits::TreatAsObject<ContainerType>::Value>::Type;
 
+template <
+	typename ElementType, typename ArrayAllocatorType, typename EncodingType, typename AllocatorType>
+auto FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TArray<ElementType, ArrayAllocatorType>& container) ->
+	typename TEnableIf<
+	Traits::TreatAsArray<TArray<ElementType, ArrayAllocatorType>>::Value>::Type;
+
+template <
+	typename ElementType, uint32 ArraySize, uint32 Alignment, typename EncodingType,
+	typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TStaticArray<ElementType, ArraySize, Alignment>& container);
+
+template <typename ElementType, size_t ArraySize, typename EncodingType, typename AllocatorType>
+auto FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	ElementType (&container)[ArraySize]) ->
+	typename TEnableIf<Traits::TreatAsArray<ElementType[ArraySize]>::Value>::Type;
+
+template <
+	typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType,
+	typename EncodingType, typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& container);
+
 template <typename DataType, typename EncodingType, typename AllocatorType>
 auto FromJson(
 	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, DataType& data) ->
@@ -92,6 +132,30 @@ auto FromJson(
 	typename TEnableIf<
 	Traits::HasFromJson<DataType, EncodingType, AllocatorType>::Value>::Type;
 
+template <typename DataType, typename EncodingType, typename AllocatorType>
+auto FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, DataType& data) ->
+	typename TEnableIf<
+	Traits::TreatAsValue<DataType>::Value &&
+	!Traits::HasFromJson<DataType, EncodingType, AllocatorType>::Value>::Type;
+
+template <typename EncodingType, typename AllocatorType>
+void FromJson(const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, FString& data);
+
+template <typename DataType, typename EncodingType, typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, TMemoized<DataType>& data);
+
+template <typename ElementType, typename EncodingType, typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TColumnar<ElementType>& data);
+
+template <typename ElementType, typename EncodingType, typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value,
+	TBase64Array<ElementType>& data);
+
 } // namespace Detail
 } // namespace Deserializer
 } // namespace Json
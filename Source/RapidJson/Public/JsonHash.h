@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Json
+{
+namespace Detail
+{
+/**
+ * 64-bit xxHash (XXH64) of a byte range.
+ *
+ * @note Used wherever the plugin needs to recognise content it has already seen (parse caches,
+ * memoized output, subtree comparisons). It is not suitable for security purposes.
+ **/
+namespace XXH64
+{
+constexpr uint64 Prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64 Prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64 Prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64 Prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64 Prime5 = 0x27D4EB2F165667C5ULL;
+
+FORCEINLINE uint64 RotateLeft(const uint64 value, const int32 shift)
+{
+	return (value << shift) | (value >> (64 - shift));
+}
+
+FORCEINLINE uint64 Read64(const uint8* data)
+{
+	uint64 value;
+	FMemory::Memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+FORCEINLINE uint32 Read32(const uint8* data)
+{
+	uint32 value;
+	FMemory::Memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+FORCEINLINE uint64 Round(uint64 accumulator, const uint64 input)
+{
+	accumulator += input * Prime2;
+	accumulator = RotateLeft(accumulator, 31);
+	return accumulator * Prime1;
+}
+
+FORCEINLINE uint64 MergeRound(uint64 accumulator, const uint64 value)
+{
+	accumulator ^= Round(0, value);
+	return accumulator * Prime1 + Prime4;
+}
+
+FORCEINLINE uint64 Avalanche(uint64 hash)
+{
+	hash ^= hash >> 33;
+	hash *= Prime2;
+	hash ^= hash >> 29;
+	hash *= Prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+} // namespace XXH64
+
+inline uint64 HashBytes(const void* const data, const SIZE_T length, const uint64 seed = 0)
+{
+	using namespace XXH64;
+
+	const uint8* cursor = static_cast<const uint8*>(data);
+	const uint8* const end = cursor + length;
+	uint64 hash;
+
+	if (length >= 32)
+	{
+		const uint8* const limit = end - 32;
+		uint64 v1 = seed + Prime1 + Prime2;
+		uint64 v2 = seed + Prime2;
+		uint64 v3 = seed;
+		uint64 v4 = seed - Prime1;
+
+		do
+		{
+			v1 = Round(v1, Read64(cursor));
+			v2 = Round(v2, Read64(cursor + 8));
+			v3 = Round(v3, Read64(cursor + 16));
+			v4 = Round(v4, Read64(cursor + 24));
+			cursor += 32;
+		} while (cursor <= limit);
+
+		hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+		hash = MergeRound(hash, v1);
+		hash = MergeRound(hash, v2);
+		hash = MergeRound(hash, v3);
+		hash = MergeRound(hash, v4);
+	}
+	else
+	{
+		hash = seed + Prime5;
+	}
+
+	hash += static_cast<uint64>(length);
+
+	for (; cursor + 8 <= end; cursor += 8)
+	{
+		hash ^= Round(0, Read64(cursor));
+		hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+	}
+
+	if (cursor + 4 <= end)
+	{
+		hash ^= static_cast<uint64>(Read32(cursor)) * Prime1;
+		hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+		cursor += 4;
+	}
+
+	for (; cursor < end; ++cursor)
+	{
+		hash ^= static_cast<uint64>(*cursor) * Prime5;
+		hash = RotateLeft(hash, 11) * Prime1;
+	}
+
+	return Avalanche(hash);
+}
+
+/** Mixes `value` into `seed`, for building hashes out of several parts. */
+FORCEINLINE uint64 HashCombine64(const uint64 seed, const uint64 value)
+{
+	return XXH64::Avalanche(seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2)));
+}
+} // namespace Detail
+} // namespace Json
@@ -0,0 +1,281 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeLock.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+namespace Detail
+{
+/** Encodings whose output can be cached, as a stable key rather than a type. */
+enum class ECachedEncoding : uint8
+{
+	None,
+	ASCII,
+	UTF8,
+	UTF16,
+	UTF32
+};
+
+template <typename EncodingType> struct CachedEncoding
+{
+	static constexpr ECachedEncoding Value = ECachedEncoding::None;
+};
+
+template <typename CharacterType> struct CachedEncoding<rapidjson::ASCII<CharacterType>>
+{
+	static constexpr ECachedEncoding Value = ECachedEncoding::ASCII;
+};
+
+template <typename CharacterType> struct CachedEncoding<rapidjson::UTF8<CharacterType>>
+{
+	static constexpr ECachedEncoding Value = ECachedEncoding::UTF8;
+};
+
+template <typename CharacterType> struct CachedEncoding<rapidjson::UTF16<CharacterType>>
+{
+	static constexpr ECachedEncoding Value = ECachedEncoding::UTF16;
+};
+
+template <typename CharacterType> struct CachedEncoding<rapidjson::UTF32<CharacterType>>
+{
+	static constexpr ECachedEncoding Value = ECachedEncoding::UTF32;
+};
+
+/** `None` for writers other than rapidjson's, whose output cannot be spliced in. */
+template <typename WriterType, bool = Traits::WriterTraits<WriterType>::Value>
+struct WriterCachedEncoding
+{
+	static constexpr ECachedEncoding Value = ECachedEncoding::None;
+};
+
+template <typename WriterType> struct WriterCachedEncoding<WriterType, true>
+{
+	static constexpr ECachedEncoding Value =
+		CachedEncoding<typename Traits::WriterTraits<WriterType>::SourceEncoding>::Value;
+};
+} // namespace Detail
+
+/**
+ * Wraps a rarely changing value and remembers its serialized form.
+ *
+ * The first serialization encodes the value as usual and keeps the bytes; later serializations
+ * splice those bytes into the output with a single raw-value write until the value is modified
+ * through `Edit` or `Set`, which bump its version and invalidate the cached bytes.
+ *
+ * @note The cached bytes are always compact JSON, so inside `SerializeToPrettyJson` a memoized
+ * value is emitted on a single line. Writers other than rapidjson's `Writer` and `PrettyWriter`
+ * simply serialize the wrapped value every time.
+ **/
+template <typename DataType>
+class TMemoized
+{
+public:
+	TMemoized() = default;
+
+	explicit TMemoized(DataType value)
+		: Value(MoveTemp(value))
+	{
+	}
+
+	TMemoized(const TMemoized& other)
+		: Value(other.Value)
+		, Version(other.Version)
+		, Encoding(other.GetEncoding())
+	{
+	}
+
+	TMemoized& operator=(const TMemoized& other)
+	{
+		if (this != &other)
+		{
+			Value = other.Value;
+			Version = other.Version;
+			SetEncoding(other.GetEncoding());
+		}
+
+		return *this;
+	}
+
+	const DataType& Get() const
+	{
+		return Value;
+	}
+
+	/**
+	 * Grants mutable access to the value for as long as the handle lives. The cached serialized
+	 * form is invalidated both when the handle is made and when it is destroyed, so changes made
+	 * through it are never hidden by bytes encoded in the meantime.
+	 **/
+	class FEditHandle
+	{
+	public:
+		explicit FEditHandle(TMemoized& owner)
+			: Owner(&owner)
+		{
+			++Owner->Version;
+		}
+
+		FEditHandle(FEditHandle&& other)
+			: Owner(other.Owner)
+		{
+			other.Owner = nullptr;
+		}
+
+		FEditHandle(const FEditHandle&) = delete;
+		FEditHandle& operator=(const FEditHandle&) = delete;
+		FEditHandle& operator=(FEditHandle&&) = delete;
+
+		~FEditHandle()
+		{
+			if (Owner != nullptr)
+			{
+				++Owner->Version;
+			}
+		}
+
+		DataType& operator*() const
+		{
+			return Owner->Value;
+		}
+
+		DataType* operator->() const
+		{
+			return &Owner->Value;
+		}
+
+	private:
+		TMemoized* Owner;
+	};
+
+	JSON_UTILS_NODISCARD FEditHandle Edit()
+	{
+		return FEditHandle{ *this };
+	}
+
+	void Set(DataType value)
+	{
+		Value = MoveTemp(value);
+		++Version;
+	}
+
+	/** Incremented by every modification; the cached bytes are only reused for the same version. */
+	uint64 GetVersion() const
+	{
+		return Version;
+	}
+
+	template <typename WriterType>
+	auto ToJson(WriterType& writer) const -> typename TEnableIf<
+		Detail::WriterCachedEncoding<WriterType>::Value != Detail::ECachedEncoding::None>::Type
+	{
+		using WriterTraitsType = Traits::WriterTraits<WriterType>;
+		using EncodingType = typename WriterTraitsType::SourceEncoding;
+		using CharacterType = typename EncodingType::Ch;
+		using ScratchBufferType = TStringBuffer<EncodingType>;
+		using ScratchWriterType = rapidjson::Writer<
+			ScratchBufferType, EncodingType, EncodingType, FCrtAllocator,
+			WriterTraitsType::Flags>;
+
+		// The bytes depend on the encoding, its unit size and the writer's flags only.
+		const uint32 format = static_cast<uint32>(Detail::CachedEncoding<EncodingType>::Value) |
+			static_cast<uint32>(sizeof(CharacterType)) << 8 | WriterTraitsType::Flags << 16;
+
+		TSharedPtr<const FEncoding, ESPMode::ThreadSafe> encoding = GetEncoding();
+		if (!encoding.IsValid() || encoding->Version != Version || encoding->Format != format)
+		{
+			ScratchBufferType buffer;
+			ScratchWriterType scratch_writer{ buffer };
+			Serializer::ToJson(scratch_writer, Value);
+
+			TSharedPtr<FEncoding, ESPMode::ThreadSafe> fresh_encoding =
+				MakeShared<FEncoding, ESPMode::ThreadSafe>();
+			fresh_encoding->Version = Version;
+			fresh_encoding->Format = format;
+			fresh_encoding->Type = FirstValueType(buffer.GetString());
+			fresh_encoding->Bytes.Append(
+				reinterpret_cast<const uint8*>(buffer.GetString()),
+				static_cast<int32>(buffer.GetSize()));
+
+			encoding = fresh_encoding;
+			SetEncoding(encoding);
+		}
+
+		writer.RawValue(
+			reinterpret_cast<const CharacterType*>(encoding->Bytes.GetData()),
+			encoding->Bytes.Num() / sizeof(CharacterType), encoding->Type);
+	}
+
+	template <typename WriterType>
+	auto ToJson(WriterType& writer) const -> typename TEnableIf<
+		Detail::WriterCachedEncoding<WriterType>::Value == Detail::ECachedEncoding::None>::Type
+	{
+		Serializer::ToJson(writer, Value);
+	}
+
+private:
+	struct FEncoding
+	{
+		uint64 Version = 0;
+		uint32 Format = 0;
+		rapidjson::Type Type = rapidjson::kNullType;
+		TArray<uint8> Bytes;
+	};
+
+	template <typename CharacterType>
+	static rapidjson::Type FirstValueType(const CharacterType* json)
+	{
+		switch (*json)
+		{
+		case '{':
+			return rapidjson::kObjectType;
+		case '[':
+			return rapidjson::kArrayType;
+		case '"':
+			return rapidjson::kStringType;
+		case 't':
+			return rapidjson::kTrueType;
+		case 'f':
+			return rapidjson::kFalseType;
+		case 'n':
+			return rapidjson::kNullType;
+		default:
+			return rapidjson::kNumberType;
+		}
+	}
+
+	TSharedPtr<const FEncoding, ESPMode::ThreadSafe> GetEncoding() const
+	{
+		FScopeLock lock(&EncodingMutex);
+		return Encoding;
+	}
+
+	void SetEncoding(TSharedPtr<const FEncoding, ESPMode::ThreadSafe> encoding) const
+	{
+		FScopeLock lock(&EncodingMutex);
+		Encoding = MoveTemp(encoding);
+	}
+
+	DataType Value{};
+	uint64 Version = 0;
+
+	// Snapshots may be encoded from several threads at once, so the cached bytes are published as
+	// an immutable shared block and only the pointer swap is guarded.
+	mutable FCriticalSection EncodingMutex;
+	mutable TSharedPtr<const FEncoding, ESPMode::ThreadSafe> Encoding;
+};
+
+namespace Deserializer
+{
+namespace Detail
+{
+template <typename DataType, typename EncodingType, typename AllocatorType>
+void FromJson(
+	const rapidjson::GenericValue<EncodingType, AllocatorType>& json_value, TMemoized<DataType>& data)
+{
+	Deserializer::FromJson(json_value, *data.Edit());
+}
+} // namespace Detail
+} // namespace Deserializer
+} // namespace Json
@@ -0,0 +1,562 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+/**
+ * Handler that encodes SAX events as MessagePack instead of JSON text.
+ *
+ * It exposes the subset of rapidjson's `Writer` interface used by `ToJson`, so every type that can
+ * be serialized to JSON (including `JSON_DEFINE`, `JSON_EXTERNAL_DEFINE` and `JSON_MAKE_ENUM`
+ * types) can be written with it unchanged. Integers use the smallest encoding that holds them and
+ * doubles that survive a round trip through `float` are stored in four bytes.
+ *
+ * @note SAX events do not announce container sizes, so every container gets a placeholder header
+ * that is patched, and shrunk when possible, once the container is closed.
+ **/
+class RAPIDJSON_API FMessagePackWriter
+{
+public:
+	typedef ANSICHAR Ch;
+
+	explicit FMessagePackWriter(TArray<uint8>& output)
+		: Output(output)
+	{
+	}
+
+	bool Null()
+	{
+		BeginValue();
+		Output.Add(0xc0);
+		return true;
+	}
+
+	bool Bool(bool value)
+	{
+		BeginValue();
+		Output.Add(value ? 0xc3 : 0xc2);
+		return true;
+	}
+
+	bool Int(int32 value)
+	{
+		return Int64(value);
+	}
+
+	bool Uint(uint32 value)
+	{
+		return Uint64(value);
+	}
+
+	bool Int64(int64 value);
+	bool Uint64(uint64 value);
+	bool Double(double value);
+
+	bool String(const Ch* string, rapidjson::SizeType length, bool copy = false);
+
+	bool String(const Ch* string)
+	{
+		return String(string, static_cast<rapidjson::SizeType>(FCStringAnsi::Strlen(string)));
+	}
+
+	bool Key(const Ch* string, rapidjson::SizeType length, bool copy = false)
+	{
+		return String(string, length, copy);
+	}
+
+	bool Key(const Ch* string)
+	{
+		return String(string);
+	}
+
+	bool StartObject()
+	{
+		return StartContainer();
+	}
+
+	bool EndObject(rapidjson::SizeType member_count = 0)
+	{
+		// Keys and values were counted separately.
+		return EndContainer(0x80, 0xde);
+	}
+
+	bool StartArray()
+	{
+		return StartContainer();
+	}
+
+	bool EndArray(rapidjson::SizeType element_count = 0)
+	{
+		return EndContainer(0x90, 0xdc);
+	}
+
+	/** Whether a complete top-level value has been written. */
+	bool IsComplete() const
+	{
+		return Containers.Num() == 0 && Output.Num() > 0;
+	}
+
+private:
+	struct FContainer
+	{
+		int32 HeaderOffset;
+		uint32 Count;
+		bool IsObject;
+	};
+
+	/** Largest header a container can need: a type byte plus a 32-bit count. */
+	static constexpr int32 PlaceholderSize = 5;
+
+	void BeginValue()
+	{
+		if (Containers.Num() > 0)
+		{
+			++Containers.Last().Count;
+		}
+	}
+
+	void PutBigEndian(uint64 value, int32 byte_count)
+	{
+		for (int32 shift = (byte_count - 1) * 8; shift >= 0; shift -= 8)
+		{
+			Output.Add(static_cast<uint8>(value >> shift));
+		}
+	}
+
+	bool StartContainer();
+	bool EndContainer(uint8 fix_type, uint8 sized_type);
+
+	TArray<uint8>& Output;
+	TArray<FContainer> Containers;
+};
+
+/**
+ * SAX-style MessagePack reader. It emits the same events as rapidjson's `Reader`, so any rapidjson
+ * handler, including `GenericDocument`, can consume MessagePack data.
+ *
+ * @note Object keys must be strings. Binary values are reported as strings and extension types
+ * are rejected.
+ **/
+class FMessagePackReader
+{
+public:
+	template <typename HandlerType>
+	bool Parse(const uint8* data, SIZE_T size, HandlerType& handler);
+
+	bool HasParseError() const
+	{
+		return Error != nullptr;
+	}
+
+	const TCHAR* GetParseError() const
+	{
+		return Error;
+	}
+
+	SIZE_T GetErrorOffset() const
+	{
+		return ErrorOffset;
+	}
+
+private:
+	struct FFrame
+	{
+		/** Keys and values still to be read; objects hold two per member. */
+		uint64 Remaining;
+		rapidjson::SizeType Count;
+		bool IsObject;
+	};
+
+	bool Fail(const TCHAR* error, const uint8* position)
+	{
+		Error = error;
+		ErrorOffset = static_cast<SIZE_T>(position - Begin);
+		return false;
+	}
+
+	static uint64 ReadBigEndian(const uint8* data, int32 byte_count)
+	{
+		uint64 value = 0;
+		for (int32 index = 0; index < byte_count; ++index)
+		{
+			value = (value << 8) | data[index];
+		}
+		return value;
+	}
+
+	const uint8* Begin = nullptr;
+	const TCHAR* Error = nullptr;
+	SIZE_T ErrorOffset = 0;
+};
+
+template <typename HandlerType>
+bool FMessagePackReader::Parse(const uint8* const data, const SIZE_T size, HandlerType& handler)
+{
+	Begin = data;
+	Error = nullptr;
+	ErrorOffset = 0;
+
+	const uint8* cursor = data;
+	const uint8* const end = data + size;
+
+	// Containers are tracked on an explicit stack so hostile input cannot exhaust the call stack.
+	TArray<FFrame> frames;
+	bool read_root = false;
+
+	while (true)
+	{
+		while (frames.Num() > 0 && frames.Last().Remaining == 0)
+		{
+			const FFrame frame = frames.Pop(false);
+			if (!(frame.IsObject ? handler.EndObject(frame.Count) : handler.EndArray(frame.Count)))
+			{
+				return Fail(TEXT("Terminated by handler."), cursor);
+			}
+		}
+
+		if (frames.Num() == 0 && read_root)
+		{
+			break;
+		}
+
+		read_root = true;
+		const bool is_key =
+			frames.Num() > 0 && frames.Last().IsObject && frames.Last().Remaining % 2 == 0;
+		if (frames.Num() > 0)
+		{
+			--frames.Last().Remaining;
+		}
+
+		if (cursor >= end)
+		{
+			return Fail(TEXT("Unexpected end of data."), cursor);
+		}
+
+		const uint8* const value_start = cursor;
+		const uint8 type = *cursor++;
+
+		const auto read = [&](int32 byte_count, uint64& value) {
+			if (end - cursor < byte_count)
+			{
+				return false;
+			}
+			value = ReadBigEndian(cursor, byte_count);
+			cursor += byte_count;
+			return true;
+		};
+
+		uint64 length = 0;
+		bool is_string = false;
+		bool is_container = false;
+		bool is_object = false;
+
+		if (type <= 0x7f || type >= 0xe0)
+		{
+			// Positive and negative fixints.
+		}
+		else if (type <= 0x8f)
+		{
+			is_container = is_object = true;
+			length = type & 0x0f;
+		}
+		else if (type <= 0x9f)
+		{
+			is_container = true;
+			length = type & 0x0f;
+		}
+		else if (type <= 0xbf)
+		{
+			is_string = true;
+			length = type & 0x1f;
+		}
+		else
+		{
+			switch (type)
+			{
+			case 0xc4:
+			case 0xd9:
+				is_string = read(1, length);
+				break;
+			case 0xc5:
+			case 0xda:
+				is_string = read(2, length);
+				break;
+			case 0xc6:
+			case 0xdb:
+				is_string = read(4, length);
+				break;
+			case 0xdc:
+				is_container = read(2, length);
+				break;
+			case 0xdd:
+				is_container = read(4, length);
+				break;
+			case 0xde:
+				is_container = is_object = read(2, length);
+				break;
+			case 0xdf:
+				is_container = is_object = read(4, length);
+				break;
+			default:
+				break;
+			}
+
+			const bool sized = type == 0xc4 || type == 0xc5 || type == 0xc6 ||
+				(type >= 0xd9 && type <= 0xdf);
+			if (sized && !is_string && !is_container)
+			{
+				return Fail(TEXT("Unexpected end of data."), cursor);
+			}
+		}
+
+		if (is_key && !is_string)
+		{
+			return Fail(TEXT("Object keys must be strings."), value_start);
+		}
+
+		bool accepted = true;
+
+		if (is_string)
+		{
+			if (static_cast<uint64>(end - cursor) < length)
+			{
+				return Fail(TEXT("Unexpected end of data."), cursor);
+			}
+
+			const ANSICHAR* const string = reinterpret_cast<const ANSICHAR*>(cursor);
+			const rapidjson::SizeType string_length = static_cast<rapidjson::SizeType>(length);
+			accepted = is_key ? handler.Key(string, string_length, true)
+							  : handler.String(string, string_length, true);
+			cursor += length;
+		}
+		else if (is_container)
+		{
+			const uint64 item_count = is_object ? length * 2 : length;
+
+			// Every item takes at least one byte, which bounds what a corrupt count can claim.
+			if (item_count > static_cast<uint64>(end - cursor))
+			{
+				return Fail(TEXT("Container size exceeds the data."), value_start);
+			}
+
+			accepted = is_object ? handler.StartObject() : handler.StartArray();
+			frames.Add(FFrame{ item_count, static_cast<rapidjson::SizeType>(length), is_object });
+		}
+		else if (type <= 0x7f)
+		{
+			accepted = handler.Uint(type);
+		}
+		else if (type >= 0xe0)
+		{
+			accepted = handler.Int(static_cast<int8>(type));
+		}
+		else
+		{
+			uint64 bits = 0;
+
+			switch (type)
+			{
+			case 0xc0:
+				accepted = handler.Null();
+				break;
+			case 0xc2:
+				accepted = handler.Bool(false);
+				break;
+			case 0xc3:
+				accepted = handler.Bool(true);
+				break;
+			case 0xca:
+			{
+				if (!read(4, bits))
+				{
+					return Fail(TEXT("Unexpected end of data."), cursor);
+				}
+				const uint32 float_bits = static_cast<uint32>(bits);
+				float value;
+				FMemory::Memcpy(&value, &float_bits, sizeof(value));
+				accepted = handler.Double(value);
+				break;
+			}
+			case 0xcb:
+			{
+				if (!read(8, bits))
+				{
+					return Fail(TEXT("Unexpected end of data."), cursor);
+				}
+				double value;
+				FMemory::Memcpy(&value, &bits, sizeof(value));
+				accepted = handler.Double(value);
+				break;
+			}
+			case 0xcc:
+			case 0xcd:
+			case 0xce:
+			case 0xcf:
+				if (!read(1 << (type - 0xcc), bits))
+				{
+					return Fail(TEXT("Unexpected end of data."), cursor);
+				}
+				accepted = bits <= MAX_uint32 ? handler.Uint(static_cast<uint32>(bits))
+											  : handler.Uint64(bits);
+				break;
+			case 0xd0:
+			case 0xd1:
+			case 0xd2:
+			case 0xd3:
+			{
+				const int32 byte_count = 1 << (type - 0xd0);
+				if (!read(byte_count, bits))
+				{
+					return Fail(TEXT("Unexpected end of data."), cursor);
+				}
+
+				// Sign-extend from the encoded width.
+				const int32 unused_bits = 64 - byte_count * 8;
+				const int64 value = static_cast<int64>(bits << unused_bits) >> unused_bits;
+				accepted = value >= MIN_int32 && value <= MAX_int32
+					? handler.Int(static_cast<int32>(value))
+					: handler.Int64(value);
+				break;
+			}
+			default:
+				return Fail(TEXT("Unsupported MessagePack type."), value_start);
+			}
+		}
+
+		if (!accepted)
+		{
+			return Fail(TEXT("Terminated by handler."), value_start);
+		}
+	}
+
+	if (cursor != end)
+	{
+		return Fail(TEXT("Unexpected data after the root value."), cursor);
+	}
+
+	return true;
+}
+
+namespace Detail
+{
+/**
+ * Holds the values of the documents decoded from MessagePack on the calling thread. Each document
+ * only lives for one call, which rewinds the arena when done, so once it has grown to fit decoding
+ * allocates nothing for the DOM.
+ **/
+class FMessagePackArenaScope
+{
+public:
+	FMessagePackArenaScope()
+		: Arena(GetThreadArena())
+		, Start(Arena.Mark())
+	{
+	}
+
+	~FMessagePackArenaScope()
+	{
+		Arena.Rewind(Start);
+
+		// Keep the memory of typical messages, not that of the largest one ever decoded.
+		if (Arena.GetStats().KeptCapacity > 4 * JSON_UTILS_ARENA_MAX_CHUNK_CAPACITY)
+		{
+			Arena.Trim();
+		}
+	}
+
+	FMessagePackArenaScope(const FMessagePackArenaScope&) = delete;
+	FMessagePackArenaScope& operator=(const FMessagePackArenaScope&) = delete;
+
+	FDocumentAllocator* Get() const
+	{
+		return &Arena;
+	}
+
+private:
+	static FDocumentAllocator& GetThreadArena()
+	{
+		static thread_local FDocumentAllocator arena;
+		return arena;
+	}
+
+	FDocumentAllocator& Arena;
+	FDocumentAllocator::FMark Start;
+};
+
+/**
+ * MessagePack is decoded into a document first and then through the same `FromJson` overloads as
+ * JSON, which keeps a single deserializer for both formats.
+ **/
+template <typename DataType>
+void DeserializeMessagePackInto(const uint8* const data, const SIZE_T size, DataType& output)
+{
+	JSON_UTILS_PARSE_SCOPE();
+
+	const FMessagePackArenaScope arena_scope;
+	TDocument<rapidjson::UTF8<>> document{ arena_scope.Get() };
+	FMessagePackReader reader;
+
+	const auto generator = [&](TDocument<rapidjson::UTF8<>>& handler) {
+		return reader.Parse(data, size, handler);
+	};
+	document.Populate(generator);
+	JSON_UTILS_STAT_ADD(ParsedDocuments, 1);
+	JSON_UTILS_STAT_ADD(ParsedBytes, size);
+
+	if (reader.HasParseError())
+	{
+		const FString message = FString::Printf(
+			TEXT("%s (offset %llu)"), reader.GetParseError(),
+			static_cast<unsigned long long>(reader.GetErrorOffset()));
+		UE_LOG(LogRapidJson, Error, TEXT("Could not parse MessagePack data: %s"), *message);
+		throw std::invalid_argument(TCHAR_TO_UTF8(*message));
+	}
+
+	Deserializer::FromJson(document, output);
+}
+} // namespace Detail
+
+/** Encodes `data` as MessagePack through the same `ToJson` overloads used for JSON. */
+template <typename DataType>
+JSON_UTILS_NODISCARD TArray<uint8> SerializeToMessagePack(const DataType& data)
+{
+	TArray<uint8> buffer;
+	FMessagePackWriter writer{ buffer };
+
+	Serializer::ToJson(writer, data);
+
+	return buffer;
+}
+
+/**
+ * Decodes MessagePack data through the same `FromJson` overloads used for JSON. Malformed data is
+ * reported like a JSON parse error.
+ **/
+template <typename ContainerType>
+JSON_UTILS_NODISCARD ContainerType DeserializeFromMessagePack(const uint8* const data, const SIZE_T size)
+{
+	static_assert(
+		TIsConstructible<ContainerType>::Value,
+		"The container must have a default constructible.");
+
+	ContainerType container;
+	Detail::DeserializeMessagePackInto(data, size, container);
+
+	return container;
+}
+
+template <typename ContainerType>
+JSON_UTILS_NODISCARD ContainerType DeserializeFromMessagePack(const TArray<uint8>& data)
+{
+	return DeserializeFromMessagePack<ContainerType>(data.GetData(), static_cast<SIZE_T>(data.Num()));
+}
+
+/** Decodes MessagePack data into an existing object, reusing its allocations. */
+template <typename DataType>
+void DeserializeFromMessagePack(const TArray<uint8>& data, DataType& output)
+{
+	Detail::DeserializeMessagePackInto(data.GetData(), static_cast<SIZE_T>(data.Num()), output);
+}
+} // namespace Json
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Json
+{
+/** UTF-8 text of a name, owned by the name cache. */
+struct FNameUtf8
+{
+	const ANSICHAR* Data = nullptr;
+	int32 Length = 0;
+};
+
+/**
+ * Caches the conversions between `FName` and the text of JSON documents.
+ *
+ * Making an `FName` from text hashes it and locks the global name table, which serializes threads
+ * decoding in parallel; writing one converts its string every time. Each thread keeps its own
+ * table of both directions, so repeated names cost a hash of the raw bytes and a lookup without
+ * any lock. Names a thread has not seen yet are looked up in a table shared by all threads before
+ * going to the name table.
+ *
+ * @note Names are told apart by their display index and number, so case differences survive in
+ * case-preserving builds. Tables are bounded and simply start over once full.
+ **/
+class RAPIDJSON_API FNameCache
+{
+public:
+	/** Returns the name spelled by `length` bytes of UTF-8 `text`. */
+	static FName FindOrAdd(const ANSICHAR* text, int32 length);
+
+	/** Returns the name spelled by `length` characters of `text`. */
+	static FName FindOrAdd(const TCHAR* text, int32 length);
+
+	/**
+	 * Returns the UTF-8 text of `name`. It stays valid until the calling thread uses the cache
+	 * again.
+	 **/
+	static FNameUtf8 ToUtf8(const FName& name);
+};
+} // namespace Json
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace Json
+{
+namespace NumberFormat
+{
+/** Buffer size that fits any text written by `FormatShortest`. */
+constexpr int32 MaxLength = 32;
+
+/**
+ * Writes the shortest decimal text that parses back to exactly `value`, laid out like rapidjson's
+ * `Writer::Double` (e.g. `0.1`, `1.0`, `1e30`), and returns its length. No terminator is written.
+ *
+ * @note `value` must be finite. The `float` overload is shortest among the decimals that round to
+ * the same `float`, so `0.1f` is written as `0.1` rather than `0.10000000149011612`.
+ **/
+RAPIDJSON_API int32 FormatShortest(double value, ANSICHAR* buffer, int32 max_decimal_places = 324);
+RAPIDJSON_API int32 FormatShortest(float value, ANSICHAR* buffer, int32 max_decimal_places = 324);
+} // namespace NumberFormat
+} // namespace Json
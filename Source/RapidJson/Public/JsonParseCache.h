@@ -0,0 +1,239 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeLock.h"
+#include "JsonHash.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+namespace Detail
+{
+/**
+ * Estimates the heap memory owned by a decoded value: string and container storage, recursively,
+ * and the fields of types declared with `JSON_DEFINE` or `JSON_EXTERNAL_DEFINE`. Other types are
+ * assumed to own nothing beyond their inline size.
+ **/
+template <typename DataType>
+auto GetHeapSize(const DataType& data) ->
+	typename TEnableIf<!Traits::HasJsonFields<DataType>::Value, SIZE_T>::Type;
+
+template <typename DataType>
+auto GetHeapSize(const DataType& data) ->
+	typename TEnableIf<Traits::HasJsonFields<DataType>::Value, SIZE_T>::Type;
+
+inline SIZE_T GetHeapSize(const FString& data);
+
+template <typename ElementType, typename AllocatorType>
+SIZE_T GetHeapSize(const TArray<ElementType, AllocatorType>& data);
+
+template <typename ElementType, typename KeyFuncsType, typename AllocatorType>
+SIZE_T GetHeapSize(const TSet<ElementType, KeyFuncsType, AllocatorType>& data);
+
+template <typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType>
+SIZE_T GetHeapSize(const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& data);
+
+template <typename DataType>
+auto GetHeapSize(const DataType&) ->
+	typename TEnableIf<!Traits::HasJsonFields<DataType>::Value, SIZE_T>::Type
+{
+	return 0;
+}
+
+template <typename DataType>
+auto GetHeapSize(const DataType& data) ->
+	typename TEnableIf<Traits::HasJsonFields<DataType>::Value, SIZE_T>::Type
+{
+	SIZE_T size = 0;
+	VisitFields(data, [&](const ANSICHAR*, auto member) { size += GetHeapSize(data.*member); });
+
+	return size;
+}
+
+inline SIZE_T GetHeapSize(const FString& data)
+{
+	return data.GetAllocatedSize();
+}
+
+template <typename ElementType, typename AllocatorType>
+SIZE_T GetHeapSize(const TArray<ElementType, AllocatorType>& data)
+{
+	SIZE_T size = data.GetAllocatedSize();
+	for (const ElementType& element : data)
+	{
+		size += GetHeapSize(element);
+	}
+
+	return size;
+}
+
+template <typename ElementType, typename KeyFuncsType, typename AllocatorType>
+SIZE_T GetHeapSize(const TSet<ElementType, KeyFuncsType, AllocatorType>& data)
+{
+	SIZE_T size = data.GetAllocatedSize();
+	for (const ElementType& element : data)
+	{
+		size += GetHeapSize(element);
+	}
+
+	return size;
+}
+
+template <typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType>
+SIZE_T GetHeapSize(const TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>& data)
+{
+	SIZE_T size = data.GetAllocatedSize();
+	for (const auto& pair : data)
+	{
+		size += GetHeapSize(pair.Key) + GetHeapSize(pair.Value);
+	}
+
+	return size;
+}
+} // namespace Detail
+
+/** Counters describing how effective a parse cache has been. */
+struct FParseCacheStats
+{
+	uint64 Hits = 0;
+	uint64 Misses = 0;
+	uint64 Evictions = 0;
+
+	/** Sum of the estimated sizes of the resident entries. */
+	SIZE_T ResidentBytes = 0;
+	int32 EntryCount = 0;
+};
+
+/**
+ * Least-recently-used cache of decoded documents, keyed by a hash of the JSON text and the type
+ * it was decoded into.
+ *
+ * Decoding unchanged content again costs a hash of the text plus a lookup, and every caller gets
+ * a shared pointer to the same immutable result. Entries are charged their source size plus the
+ * size of the decoded value, heap storage included (see `Detail::GetHeapSize`), against the memory
+ * budget; the least recently used entries are evicted once the budget is exceeded.
+ *
+ * @note The cache is opt-in and thread-safe. Content is identified by its 64-bit hash and length
+ * only, so two different documents colliding on both would share an entry.
+ **/
+class RAPIDJSON_API FParseCache
+{
+public:
+	static constexpr SIZE_T DefaultBudgetBytes = 16 * 1024 * 1024;
+
+	explicit FParseCache(SIZE_T budget_bytes = DefaultBudgetBytes);
+	~FParseCache();
+
+	FParseCache(const FParseCache&) = delete;
+	FParseCache& operator=(const FParseCache&) = delete;
+
+	/**
+	 * Returns the decoded form of `json`, decoding and caching it on a miss. Parse errors are
+	 * reported exactly like `DeserializeFromJson` and nothing is cached for them.
+	 **/
+	template <typename DataType>
+	TSharedPtr<const DataType, ESPMode::ThreadSafe> Deserialize(const ANSICHAR* json);
+
+	template <typename DataType>
+	TSharedPtr<const DataType, ESPMode::ThreadSafe> Deserialize(const TCHAR* json);
+
+	template <typename DataType>
+	TSharedPtr<const DataType, ESPMode::ThreadSafe> Deserialize(const FString& json);
+
+	/** Changes the memory budget, evicting entries right away if it shrank. */
+	void SetBudget(SIZE_T budget_bytes);
+
+	/** Drops every entry. Results already handed out stay valid. */
+	void Empty();
+
+	FParseCacheStats GetStats() const;
+
+private:
+	struct FKey
+	{
+		uint64 Hash;
+		SIZE_T Length;
+		const void* Type;
+
+		bool operator==(const FKey& other) const
+		{
+			return Hash == other.Hash && Length == other.Length && Type == other.Type;
+		}
+
+		friend uint32 GetTypeHash(const FKey& key)
+		{
+			return static_cast<uint32>(key.Hash) ^ static_cast<uint32>(key.Hash >> 32);
+		}
+	};
+
+	struct FEntry
+	{
+		FKey Key;
+		TSharedPtr<const void, ESPMode::ThreadSafe> Value;
+		SIZE_T Cost;
+		FEntry* Newer;
+		FEntry* Older;
+	};
+
+	template <typename DataType, typename CharacterType>
+	TSharedPtr<const DataType, ESPMode::ThreadSafe> Deserialize(const CharacterType* json, SIZE_T length);
+
+	TSharedPtr<const void, ESPMode::ThreadSafe> Find(const FKey& key);
+	TSharedPtr<const void, ESPMode::ThreadSafe> Add(
+		const FKey& key, TSharedPtr<const void, ESPMode::ThreadSafe> value, SIZE_T cost);
+
+	void Unlink(FEntry* entry);
+	void LinkAsNewest(FEntry* entry);
+	void EvictToBudget();
+
+	mutable FCriticalSection Mutex;
+	TMap<FKey, FEntry*> Entries;
+	FEntry* Newest = nullptr;
+	FEntry* Oldest = nullptr;
+	SIZE_T BudgetBytes;
+	FParseCacheStats Stats;
+};
+
+template <typename DataType, typename CharacterType>
+TSharedPtr<const DataType, ESPMode::ThreadSafe> FParseCache::Deserialize(
+	const CharacterType* const json, const SIZE_T length)
+{
+	const SIZE_T byte_length = length * sizeof(CharacterType);
+	const FKey key{ Detail::HashBytes(json, byte_length), byte_length, Traits::TypeId<DataType>() };
+
+	if (const auto cached = Find(key))
+	{
+		return StaticCastSharedPtr<const DataType>(cached);
+	}
+
+	static_assert(
+		TIsConstructible<DataType>::Value,
+		"The container must have a default constructible.");
+
+	// Decode outside the lock; concurrent misses on the same content may decode twice, but only
+	// the first result is kept and handed out.
+	TSharedPtr<DataType, ESPMode::ThreadSafe> decoded = MakeShared<DataType, ESPMode::ThreadSafe>();
+	DeserializeFromJson(json, *decoded);
+
+	const SIZE_T cost = byte_length + sizeof(DataType) + Detail::GetHeapSize(*decoded);
+	return StaticCastSharedPtr<const DataType>(Add(key, MoveTemp(decoded), cost));
+}
+
+template <typename DataType>
+TSharedPtr<const DataType, ESPMode::ThreadSafe> FParseCache::Deserialize(const ANSICHAR* const json)
+{
+	return Deserialize<DataType>(json, static_cast<SIZE_T>(FCStringAnsi::Strlen(json)));
+}
+
+template <typename DataType>
+TSharedPtr<const DataType, ESPMode::ThreadSafe> FParseCache::Deserialize(const TCHAR* const json)
+{
+	return Deserialize<DataType>(json, static_cast<SIZE_T>(FCString::Strlen(json)));
+}
+
+template <typename DataType>
+TSharedPtr<const DataType, ESPMode::ThreadSafe> FParseCache::Deserialize(const FString& json)
+{
+	return Deserialize<DataType>(*json, static_cast<SIZE_T>(json.Len()));
+}
+} // namespace Json
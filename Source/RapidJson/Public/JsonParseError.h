@@ -0,0 +1,159 @@
+#pragma once
+
+#include <rapidjson/error/en.h>
+#include "CoreMinimal.h"
+
+namespace Json
+{
+/**
+ * Position of a parse error inside the original source text.
+ *
+ * @note The parser only records the byte (code unit) offset of the failure. Lines, columns and the
+ * snippet are recovered afterwards by rescanning the source, so successful parses pay nothing for
+ * them.
+ **/
+struct FParseErrorLocation
+{
+	/** Offset of the error in code units of the source encoding. */
+	size_t Offset = 0;
+
+	/** One-based line number. */
+	size_t Line = 1;
+
+	/** One-based column number, counted in code units. */
+	size_t Column = 1;
+
+	/** The text surrounding the error on its line, followed by a caret line pointing at it. */
+	FString Snippet;
+};
+
+namespace Detail
+{
+/** Maximum number of characters shown on either side of the error in a snippet. */
+constexpr size_t ParseErrorSnippetRadius = 40;
+
+/**
+ * Whether `character` continues a code point started by an earlier unit, so that a snippet must not
+ * start or end on it.
+ **/
+inline bool IsContinuationUnit(const ANSICHAR character)
+{
+	return (static_cast<uint8>(character) & 0xC0) == 0x80;
+}
+
+/** The low half of a surrogate pair, for UTF-16 `TCHAR`s. */
+inline bool IsContinuationUnit(const TCHAR character)
+{
+	return sizeof(TCHAR) == 2 && character >= 0xDC00 && character <= 0xDFFF;
+}
+
+inline FString MakeSnippetString(const ANSICHAR* first, const ANSICHAR* last)
+{
+	const FUTF8ToTCHAR converted{ first, static_cast<int32>(last - first) };
+	return FString(converted.Length(), converted.Get());
+}
+
+inline FString MakeSnippetString(const TCHAR* first, const TCHAR* last)
+{
+	return FString(static_cast<int32>(last - first), first);
+}
+} // namespace Detail
+
+/**
+ * Computes the line, column and a short snippet for an error reported at `offset`.
+ *
+ * @param source Null-terminated text that was handed to the parser.
+ * @param offset Value of `GetErrorOffset()` for the failed parse.
+ **/
+template <typename CharacterType>
+FParseErrorLocation LocateParseError(const CharacterType* const source, const size_t offset)
+{
+	FParseErrorLocation location;
+	location.Offset = offset;
+
+	if (source == nullptr)
+	{
+		return location;
+	}
+
+	// The offset may point one past the end of the text (e.g. an unterminated document), so stop
+	// at the terminator rather than trusting it blindly.
+	const CharacterType* line_start = source;
+	const CharacterType* cursor = source;
+	for (; cursor < source + offset && *cursor != '\0'; ++cursor)
+	{
+		if (*cursor == '\n')
+		{
+			++location.Line;
+			line_start = cursor + 1;
+		}
+	}
+
+	location.Column = static_cast<size_t>(cursor - line_start) + 1;
+
+	const CharacterType* snippet_start = line_start;
+	if (cursor - snippet_start > static_cast<ptrdiff_t>(Detail::ParseErrorSnippetRadius))
+	{
+		snippet_start = cursor - Detail::ParseErrorSnippetRadius;
+		while (snippet_start < cursor && Detail::IsContinuationUnit(*snippet_start))
+		{
+			++snippet_start;
+		}
+	}
+
+	const CharacterType* snippet_end = cursor;
+	while (*snippet_end != '\0' && *snippet_end != '\n' && *snippet_end != '\r' &&
+		snippet_end - cursor < static_cast<ptrdiff_t>(Detail::ParseErrorSnippetRadius))
+	{
+		++snippet_end;
+	}
+
+	while (snippet_end > cursor && Detail::IsContinuationUnit(*snippet_end))
+	{
+		--snippet_end;
+	}
+
+	const FString before_error = Detail::MakeSnippetString(snippet_start, cursor);
+	location.Snippet = before_error + Detail::MakeSnippetString(cursor, snippet_end);
+	location.Snippet += TEXT("\n");
+	for (int32 index = 0; index < before_error.Len(); ++index)
+	{
+		location.Snippet += before_error[index] == '\t' ? TEXT('\t') : TEXT(' ');
+	}
+	location.Snippet += TEXT("^");
+
+	return location;
+}
+
+/**
+ * Builds the message logged for a failed parse when only the offset is known, e.g. because the
+ * document was read from a stream.
+ **/
+inline FString DescribeParseError(const rapidjson::ParseResult& result)
+{
+	return FString::Printf(
+		TEXT("%s (offset %llu)"), UTF8_TO_TCHAR(rapidjson::GetParseError_En(result.Code())),
+		static_cast<unsigned long long>(result.Offset()));
+}
+
+/**
+ * Builds the message logged for a failed parse, including the line, column and a snippet of
+ * `source` around the error.
+ **/
+template <typename CharacterType>
+FString DescribeParseError(const rapidjson::ParseResult& result, const CharacterType* const source)
+{
+	if (source == nullptr)
+	{
+		return DescribeParseError(result);
+	}
+
+	const FParseErrorLocation location = LocateParseError(source, result.Offset());
+	return FString::Printf(
+		TEXT("%s (line %llu, column %llu, offset %llu)\n%s"),
+		UTF8_TO_TCHAR(rapidjson::GetParseError_En(result.Code())),
+		static_cast<unsigned long long>(location.Line),
+		static_cast<unsigned long long>(location.Column),
+		static_cast<unsigned long long>(location.Offset), *location.Snippet);
+}
+} // namespace Json
@@ -0,0 +1,735 @@
+#pragma once
+
+#include <rapidjson/document.h>
+#include <rapidjson/pointer.h>
+#include "CoreMinimal.h"
+#include "JsonFields.h"
+#include "JsonHash.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+namespace Detail
+{
+/**
+ * Content hashes of every value in one or more documents, keyed by the value's address.
+ *
+ * @note Object hashes ignore member order, matching `GenericValue::operator==`. Integers and
+ * doubles hash differently even when they compare equal, which at worst turns an unchanged number
+ * into a redundant `replace`.
+ **/
+template <typename ValueType>
+class TJsonHashes
+{
+public:
+	uint64 Get(const ValueType& value) const
+	{
+		return Hashes.FindChecked(&value);
+	}
+
+	uint64 Add(const ValueType& value)
+	{
+		using CharacterType = typename ValueType::Ch;
+
+		uint64 hash = static_cast<uint64>(value.GetType());
+
+		switch (value.GetType())
+		{
+		case rapidjson::kStringType:
+			hash = HashBytes(
+				value.GetString(), value.GetStringLength() * sizeof(CharacterType), hash);
+			break;
+		case rapidjson::kNumberType:
+			hash = HashCombine64(hash, NumberBits(value));
+			break;
+		case rapidjson::kArrayType:
+			for (const auto& element : value.GetArray())
+			{
+				hash = HashCombine64(hash, Add(element));
+			}
+			break;
+		case rapidjson::kObjectType:
+		{
+			uint64 members = 0;
+			for (const auto& member : value.GetObject())
+			{
+				const uint64 name = HashBytes(
+					member.name.GetString(), member.name.GetStringLength() * sizeof(CharacterType));
+				members += HashCombine64(name, Add(member.value));
+			}
+			hash = HashCombine64(hash, members);
+			break;
+		}
+		default:
+			// Null, true and false are fully described by their type.
+			break;
+		}
+
+		Hashes.Add(&value, hash);
+		return hash;
+	}
+
+private:
+	static uint64 NumberBits(const ValueType& value)
+	{
+		if (value.IsDouble())
+		{
+			// Fold -0.0 into 0.0, which compare equal.
+			const double number = value.GetDouble() == 0.0 ? 0.0 : value.GetDouble();
+			uint64 bits;
+			FMemory::Memcpy(&bits, &number, sizeof(bits));
+			return bits;
+		}
+
+		return value.IsUint64() ? value.GetUint64() : static_cast<uint64>(value.GetInt64());
+	}
+
+	TMap<const ValueType*, uint64> Hashes;
+};
+
+/** Copies an ASCII literal into a string value of any encoding. */
+template <typename ValueType, typename AllocatorType>
+ValueType MakeAsciiString(const ANSICHAR* text, AllocatorType& allocator)
+{
+	const int32 length = FCStringAnsi::Strlen(text);
+
+	// Operation names and member names fit inline; anything longer goes to the heap.
+	TArray<typename ValueType::Ch, TInlineAllocator<16>> buffer;
+	buffer.SetNumUninitialized(length);
+	for (int32 index = 0; index < length; ++index)
+	{
+		buffer[index] = static_cast<typename ValueType::Ch>(text[index]);
+	}
+
+	return ValueType(buffer.GetData(), static_cast<rapidjson::SizeType>(length), allocator);
+}
+
+template <typename ValueType>
+const ValueType* FindAsciiMember(const ValueType& object, const ANSICHAR* name)
+{
+	for (const auto& member : object.GetObject())
+	{
+		if (FieldNameEquals(member.name.GetString(), member.name.GetStringLength(), name))
+		{
+			return &member.value;
+		}
+	}
+
+	return nullptr;
+}
+
+template <typename ValueType>
+FString PointerToString(const ValueType& path)
+{
+	return MakeSnippetString(path.GetString(), path.GetString() + path.GetStringLength());
+}
+
+/**
+ * Builds a JSON Patch (RFC 6902) between two values.
+ *
+ * Both values are hashed once up front, which lets the diff skip identical subtrees with a single
+ * comparison and compare array elements cheaply. Arrays are trimmed of their common prefix and
+ * suffix; the remainder is aligned with a longest common subsequence over the element hashes, and
+ * unmatched elements facing each other are diffed recursively instead of being removed and added
+ * back.
+ **/
+template <typename ValueType, typename PatchDocumentType>
+class TJsonPatchBuilder
+{
+public:
+	using CharacterType = typename ValueType::Ch;
+	using PatchValueType = typename PatchDocumentType::ValueType;
+
+	/** Above this many cells the LCS table is skipped and array elements are paired by index. */
+	static constexpr uint64 MaxLcsCells = 4 * 1024 * 1024;
+
+	explicit TJsonPatchBuilder(PatchDocumentType& patch)
+		: Patch(patch)
+	{
+	}
+
+	void Diff(const ValueType& source, const ValueType& target)
+	{
+		Hashes.Add(source);
+		Hashes.Add(target);
+
+		Patch.SetArray();
+		DiffValues(source, target);
+	}
+
+private:
+	enum class EEdit : uint8
+	{
+		Keep,
+		Remove,
+		Insert
+	};
+
+	void DiffValues(const ValueType& source, const ValueType& target)
+	{
+		if (Hashes.Get(source) == Hashes.Get(target))
+		{
+			return;
+		}
+
+		if (source.IsObject() && target.IsObject())
+		{
+			DiffObjects(source, target);
+		}
+		else if (source.IsArray() && target.IsArray())
+		{
+			DiffArrays(source, target);
+		}
+		else
+		{
+			Emit("replace", &target);
+		}
+	}
+
+	void DiffObjects(const ValueType& source, const ValueType& target)
+	{
+		const rapidjson::SizeType target_count = target.MemberCount();
+
+		TBitArray<> matched(false, static_cast<int32>(target_count));
+
+		rapidjson::SizeType position = 0;
+		for (auto source_member = source.MemberBegin(); source_member != source.MemberEnd();
+			 ++source_member, ++position)
+		{
+			// Members usually keep their order between revisions, so try the same position before
+			// searching.
+			auto target_member = target.MemberEnd();
+			if (position < target_count &&
+				target.MemberBegin()[position].name == source_member->name)
+			{
+				target_member = target.MemberBegin() + position;
+			}
+			else
+			{
+				JSON_UTILS_STAT_ADD(MemberLookups, 1);
+				target_member = target.FindMember(source_member->name);
+			}
+
+			const int32 saved_length = PushToken(source_member->name);
+
+			if (target_member == target.MemberEnd())
+			{
+				Emit("remove", nullptr);
+			}
+			else
+			{
+				matched[static_cast<int32>(target_member - target.MemberBegin())] = true;
+				DiffValues(source_member->value, target_member->value);
+			}
+
+			Path.SetNum(saved_length, false);
+		}
+
+		position = 0;
+		for (auto target_member = target.MemberBegin(); target_member != target.MemberEnd();
+			 ++target_member, ++position)
+		{
+			if (!matched[static_cast<int32>(position)])
+			{
+				const int32 saved_length = PushToken(target_member->name);
+				Emit("add", &target_member->value);
+				Path.SetNum(saved_length, false);
+			}
+		}
+	}
+
+	void DiffArrays(const ValueType& source, const ValueType& target)
+	{
+		const rapidjson::SizeType source_size = source.Size();
+		const rapidjson::SizeType target_size = target.Size();
+		const rapidjson::SizeType common_size = FMath::Min(source_size, target_size);
+
+		rapidjson::SizeType prefix = 0;
+		while (prefix < common_size && Hashes.Get(source[prefix]) == Hashes.Get(target[prefix]))
+		{
+			++prefix;
+		}
+
+		rapidjson::SizeType suffix = 0;
+		while (suffix < common_size - prefix &&
+			Hashes.Get(source[source_size - 1 - suffix]) ==
+			Hashes.Get(target[target_size - 1 - suffix]))
+		{
+			++suffix;
+		}
+
+		const rapidjson::SizeType source_count = source_size - prefix - suffix;
+		const rapidjson::SizeType target_count = target_size - prefix - suffix;
+
+		TArray<EEdit> script;
+		BuildEditScript(source, target, prefix, source_count, target_count, script);
+
+		// Operations apply one after another, so `index` tracks where the next source element sits
+		// in the partially patched array.
+		rapidjson::SizeType index = prefix;
+		rapidjson::SizeType source_index = prefix;
+		rapidjson::SizeType target_index = prefix;
+		int32 removals = 0;
+		int32 insertions = 0;
+
+		const auto flush = [&]() {
+			for (; removals > 0 && insertions > 0; --removals, --insertions)
+			{
+				const int32 saved_length = PushIndex(index++);
+				DiffValues(source[source_index++], target[target_index++]);
+				Path.SetNum(saved_length, false);
+			}
+
+			for (; removals > 0; --removals, ++source_index)
+			{
+				const int32 saved_length = PushIndex(index);
+				Emit("remove", nullptr);
+				Path.SetNum(saved_length, false);
+			}
+
+			for (; insertions > 0; --insertions)
+			{
+				const int32 saved_length = PushIndex(index++);
+				Emit("add", &target[target_index++]);
+				Path.SetNum(saved_length, false);
+			}
+		};
+
+		for (const EEdit edit : script)
+		{
+			switch (edit)
+			{
+			case EEdit::Keep:
+				flush();
+				++index;
+				++source_index;
+				++target_index;
+				break;
+			case EEdit::Remove:
+				++removals;
+				break;
+			case EEdit::Insert:
+				++insertions;
+				break;
+			}
+		}
+
+		flush();
+	}
+
+	void BuildEditScript(
+		const ValueType& source, const ValueType& target, const rapidjson::SizeType offset,
+		const rapidjson::SizeType source_count, const rapidjson::SizeType target_count,
+		TArray<EEdit>& script) const
+	{
+		script.Reserve(static_cast<int32>(source_count + target_count));
+
+		const uint64 cells = static_cast<uint64>(source_count + 1) * (target_count + 1);
+		if (source_count == 0 || target_count == 0 || cells > MaxLcsCells)
+		{
+			script.Init(EEdit::Remove, static_cast<int32>(source_count));
+			for (rapidjson::SizeType index = 0; index < target_count; ++index)
+			{
+				script.Add(EEdit::Insert);
+			}
+			return;
+		}
+
+		// lengths[i][j] is the LCS length of source[i..] and target[j..].
+		const uint64 stride = target_count + 1;
+		TArray<uint32> lengths;
+		lengths.SetNumZeroed(static_cast<int32>(cells));
+
+		for (int64 i = static_cast<int64>(source_count) - 1; i >= 0; --i)
+		{
+			const uint64 source_hash = Hashes.Get(source[offset + static_cast<rapidjson::SizeType>(i)]);
+			for (int64 j = static_cast<int64>(target_count) - 1; j >= 0; --j)
+			{
+				uint32& cell = lengths[i * stride + j];
+				if (source_hash == Hashes.Get(target[offset + static_cast<rapidjson::SizeType>(j)]))
+				{
+					cell = lengths[(i + 1) * stride + j + 1] + 1;
+				}
+				else
+				{
+					cell = FMath::Max(lengths[(i + 1) * stride + j], lengths[i * stride + j + 1]);
+				}
+			}
+		}
+
+		uint64 i = 0;
+		uint64 j = 0;
+		while (i < source_count && j < target_count)
+		{
+			if (Hashes.Get(source[offset + static_cast<rapidjson::SizeType>(i)]) ==
+				Hashes.Get(target[offset + static_cast<rapidjson::SizeType>(j)]))
+			{
+				script.Add(EEdit::Keep);
+				++i;
+				++j;
+			}
+			else if (lengths[(i + 1) * stride + j] >= lengths[i * stride + j + 1])
+			{
+				script.Add(EEdit::Remove);
+				++i;
+			}
+			else
+			{
+				script.Add(EEdit::Insert);
+				++j;
+			}
+		}
+
+		for (; i < source_count; ++i)
+		{
+			script.Add(EEdit::Remove);
+		}
+
+		for (; j < target_count; ++j)
+		{
+			script.Add(EEdit::Insert);
+		}
+	}
+
+	/** Appends an escaped reference token and returns the previous path length. */
+	int32 PushToken(const ValueType& name)
+	{
+		const int32 saved_length = Path.Num();
+		Path.Add('/');
+
+		const CharacterType* const characters = name.GetString();
+		for (rapidjson::SizeType index = 0; index < name.GetStringLength(); ++index)
+		{
+			switch (characters[index])
+			{
+			case '~':
+				Path.Add('~');
+				Path.Add('0');
+				break;
+			case '/':
+				Path.Add('~');
+				Path.Add('1');
+				break;
+			default:
+				Path.Add(characters[index]);
+				break;
+			}
+		}
+
+		return saved_length;
+	}
+
+	int32 PushIndex(rapidjson::SizeType index)
+	{
+		const int32 saved_length = Path.Num();
+		Path.Add('/');
+
+		CharacterType digits[10];
+		int32 count = 0;
+		do
+		{
+			digits[count++] = static_cast<CharacterType>('0' + index % 10);
+			index /= 10;
+		} while (index != 0);
+
+		while (count > 0)
+		{
+			Path.Add(digits[--count]);
+		}
+
+		return saved_length;
+	}
+
+	void Emit(const ANSICHAR* operation_name, const ValueType* value)
+	{
+		auto& allocator = Patch.GetAllocator();
+
+		PatchValueType operation(rapidjson::kObjectType);
+		operation.AddMember(
+			MakeAsciiString<PatchValueType>("op", allocator),
+			MakeAsciiString<PatchValueType>(operation_name, allocator), allocator);
+		operation.AddMember(
+			MakeAsciiString<PatchValueType>("path", allocator),
+			PatchValueType(Path.GetData(), static_cast<rapidjson::SizeType>(Path.Num()), allocator),
+			allocator);
+
+		if (value != nullptr)
+		{
+			operation.AddMember(
+				MakeAsciiString<PatchValueType>("value", allocator), PatchValueType(*value, allocator),
+				allocator);
+		}
+
+		Patch.PushBack(operation, allocator);
+	}
+
+	PatchDocumentType& Patch;
+	TJsonHashes<ValueType> Hashes;
+	TArray<CharacterType> Path;
+};
+
+template <typename ValueType>
+ValueType* ResolveParent(ValueType& root, const rapidjson::GenericPointer<ValueType>& pointer)
+{
+	const rapidjson::GenericPointer<ValueType> parent_pointer(
+		pointer.GetTokens(), pointer.GetTokenCount() - 1);
+	return parent_pointer.Get(root);
+}
+
+/** Inserts `value` at `pointer` following the semantics of the `add` operation. */
+template <typename ValueType, typename AllocatorType>
+bool AddAtPointer(
+	ValueType& root, const rapidjson::GenericPointer<ValueType>& pointer, ValueType& value,
+	AllocatorType& allocator)
+{
+	if (pointer.GetTokenCount() == 0)
+	{
+		root = value;
+		return true;
+	}
+
+	ValueType* const parent = ResolveParent(root, pointer);
+	const auto& token = pointer.GetTokens()[pointer.GetTokenCount() - 1];
+
+	if (parent != nullptr && parent->IsObject())
+	{
+		JSON_UTILS_STAT_ADD(MemberLookups, 1);
+		const auto member = parent->FindMember(ValueType(rapidjson::StringRef(token.name, token.length)));
+		if (member != parent->MemberEnd())
+		{
+			member->value = value;
+		}
+		else
+		{
+			parent->AddMember(ValueType(token.name, token.length, allocator), value, allocator);
+		}
+		return true;
+	}
+
+	if (parent != nullptr && parent->IsArray())
+	{
+		if (token.length == 1 && token.name[0] == '-')
+		{
+			parent->PushBack(value, allocator);
+			return true;
+		}
+
+		if (token.index != rapidjson::kPointerInvalidIndex && token.index <= parent->Size())
+		{
+			parent->PushBack(value, allocator);
+			for (rapidjson::SizeType index = parent->Size() - 1; index > token.index; --index)
+			{
+				(*parent)[index].Swap((*parent)[index - 1]);
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** Detaches the value at `pointer` into `removed`. The root itself cannot be removed. */
+template <typename ValueType>
+bool RemoveAtPointer(
+	ValueType& root, const rapidjson::GenericPointer<ValueType>& pointer, ValueType& removed)
+{
+	if (pointer.GetTokenCount() == 0)
+	{
+		return false;
+	}
+
+	ValueType* const parent = ResolveParent(root, pointer);
+	const auto& token = pointer.GetTokens()[pointer.GetTokenCount() - 1];
+
+	if (parent != nullptr && parent->IsObject())
+	{
+		JSON_UTILS_STAT_ADD(MemberLookups, 1);
+		const auto member = parent->FindMember(ValueType(rapidjson::StringRef(token.name, token.length)));
+		if (member != parent->MemberEnd())
+		{
+			removed.Swap(member->value);
+			parent->EraseMember(member);
+			return true;
+		}
+	}
+	else if (parent != nullptr && parent->IsArray())
+	{
+		if (token.index != rapidjson::kPointerInvalidIndex && token.index < parent->Size())
+		{
+			removed.Swap((*parent)[token.index]);
+			parent->Erase(parent->Begin() + token.index);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template <typename ValueType, typename PatchValueType, typename AllocatorType>
+bool ApplyPatchOperation(ValueType& root, const PatchValueType& operation, AllocatorType& allocator)
+{
+	using PointerType = rapidjson::GenericPointer<ValueType>;
+
+	const PatchValueType* const name = operation.IsObject() ? FindAsciiMember(operation, "op") : nullptr;
+	const PatchValueType* const path = operation.IsObject() ? FindAsciiMember(operation, "path") : nullptr;
+	if (name == nullptr || !name->IsString() || path == nullptr || !path->IsString())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("JSON Patch operation is missing its op or path."));
+		return false;
+	}
+
+	const PointerType pointer(path->GetString(), path->GetStringLength());
+	if (!pointer.IsValid())
+	{
+		UE_LOG(LogRapidJson, Error, TEXT("Invalid JSON pointer %s."), *PointerToString(*path));
+		return false;
+	}
+
+	const auto is_operation = [name](const ANSICHAR* operation_name) {
+		return FieldNameEquals(name->GetString(), name->GetStringLength(), operation_name);
+	};
+
+	const PatchValueType* const value = FindAsciiMember(operation, "value");
+	const PatchValueType* const from = FindAsciiMember(operation, "from");
+	const bool needs_value = is_operation("add") || is_operation("replace") || is_operation("test");
+	const bool needs_from = is_operation("move") || is_operation("copy");
+
+	if ((needs_value && value == nullptr) || (needs_from && (from == nullptr || !from->IsString())))
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("JSON Patch operation at %s is missing its operand."),
+			*PointerToString(*path));
+		return false;
+	}
+
+	bool succeeded = false;
+
+	if (is_operation("add"))
+	{
+		ValueType copy(*value, allocator);
+		succeeded = AddAtPointer(root, pointer, copy, allocator);
+	}
+	else if (is_operation("remove"))
+	{
+		ValueType removed;
+		succeeded = RemoveAtPointer(root, pointer, removed);
+	}
+	else if (is_operation("replace"))
+	{
+		if (ValueType* const target = pointer.Get(root))
+		{
+			*target = ValueType(*value, allocator);
+			succeeded = true;
+		}
+	}
+	else if (is_operation("test"))
+	{
+		const ValueType* const target = pointer.Get(root);
+		succeeded = target != nullptr && *target == *value;
+	}
+	else if (needs_from)
+	{
+		const PointerType from_pointer(from->GetString(), from->GetStringLength());
+
+		if (!from_pointer.IsValid())
+		{
+			UE_LOG(LogRapidJson, Error, TEXT("Invalid JSON pointer %s."), *PointerToString(*from));
+			return false;
+		}
+
+		if (is_operation("copy"))
+		{
+			if (const ValueType* const source = from_pointer.Get(root))
+			{
+				ValueType copy(*source, allocator);
+				succeeded = AddAtPointer(root, pointer, copy, allocator);
+			}
+		}
+		else if (from_pointer == pointer)
+		{
+			succeeded = from_pointer.Get(root) != nullptr;
+		}
+		else
+		{
+			// A value cannot be moved into one of its own children.
+			const bool into_itself = from_pointer.GetTokenCount() < pointer.GetTokenCount() &&
+				PointerType(pointer.GetTokens(), from_pointer.GetTokenCount()) == from_pointer;
+
+			ValueType moved;
+			succeeded = !into_itself && RemoveAtPointer(root, from_pointer, moved) &&
+				AddAtPointer(root, pointer, moved, allocator);
+		}
+	}
+	else
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Unknown JSON Patch operation %s."),
+			*PointerToString(*name));
+		return false;
+	}
+
+	if (!succeeded)
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("JSON Patch operation %s failed at %s."),
+			*PointerToString(*name), *PointerToString(*path));
+	}
+
+	return succeeded;
+}
+} // namespace Detail
+
+/**
+ * Writes into `patch` a JSON Patch (RFC 6902) array that turns `source` into `target`.
+ *
+ * @note Unchanged subtrees are recognised by a 64-bit content hash rather than a full
+ * comparison, so two different subtrees colliding on it would be treated as identical.
+ **/
+template <typename ValueType, typename PatchDocumentType>
+void CreateJsonPatch(const ValueType& source, const ValueType& target, PatchDocumentType& patch)
+{
+	Detail::TJsonPatchBuilder<ValueType, PatchDocumentType> builder{ patch };
+	builder.Diff(source, target);
+}
+
+/**
+ * Applies a JSON Patch array to `root` in place, allocating new values from `allocator`.
+ *
+ * @return false as soon as an operation fails (including a failed `test`).
+ * @note Operations are not rolled back on failure, which would require copying the whole
+ * document up front. Apply to a copy when a partially applied patch is not acceptable.
+ **/
+template <typename ValueType, typename PatchValueType, typename AllocatorType>
+bool ApplyJsonPatch(ValueType& root, const PatchValueType& patch, AllocatorType& allocator)
+{
+	if (!patch.IsArray())
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Expected a JSON Patch array, got %s."),
+			*Deserializer::Detail::TypeToString(patch));
+		return false;
+	}
+
+	for (const auto& operation : patch.GetArray())
+	{
+		if (!Detail::ApplyPatchOperation(root, operation, allocator))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <
+	typename EncodingType, typename AllocatorType, typename StackAllocatorType,
+	typename PatchValueType>
+bool ApplyJsonPatch(
+	rapidjson::GenericDocument<EncodingType, AllocatorType, StackAllocatorType>& document,
+	const PatchValueType& patch)
+{
+	return ApplyJsonPatch(
+		static_cast<rapidjson::GenericValue<EncodingType, AllocatorType>&>(document), patch,
+		document.GetAllocator());
+}
+} // namespace Json
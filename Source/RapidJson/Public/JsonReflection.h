@@ -0,0 +1,468 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+#include "JsonUtils.h"
+
+namespace Json
+{
+/** How a reflected value is encoded, resolved once from its property class. */
+enum class EPropertyPlanKind : uint8
+{
+	Bool,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64,
+	Float,
+	Double,
+	/** Written as the name of the value, read from either the name or the number. */
+	Enum,
+	String,
+	Name,
+	Text,
+	Struct,
+	/** A C array member (`ArrayDim > 1`), written as a JSON array of `ArrayDim` elements. */
+	StaticArray,
+	Array,
+	Set,
+	/** Written as an object; keys must be strings, names, enums or integers. */
+	Map,
+};
+
+class FStructPlan;
+
+/** One name of an enum, already encoded as UTF-8. */
+struct FEnumPlanEntry
+{
+	int64 Value;
+	TArray<ANSICHAR> Name;
+};
+
+/** Encoding of one value: a property of a struct, or the element, key or value of a container. */
+struct FPropertyValuePlan
+{
+	EPropertyPlanKind Kind = EPropertyPlanKind::Bool;
+	const FProperty* Property = nullptr;
+
+	/** Nested struct, for `Struct`. */
+	const FStructPlan* Struct = nullptr;
+
+	/** Integer property holding the value and the names of the values, for `Enum`. */
+	const FNumericProperty* Underlying = nullptr;
+	TArray<FEnumPlanEntry> EnumEntries;
+
+	/** Element of a `StaticArray`, `Array` or `Set`, or key of a `Map`. */
+	TUniquePtr<FPropertyValuePlan> Element;
+
+	/** Value of a `Map`. */
+	TUniquePtr<FPropertyValuePlan> Value;
+
+	/** Element count and stride of a `StaticArray`. */
+	int32 ArrayDim = 1;
+	int32 ElementSize = 0;
+};
+
+/** One serialized property of a struct. */
+struct FPropertyFieldPlan
+{
+	/** Name of the property as written in JSON, encoded as UTF-8 once. */
+	TArray<ANSICHAR> Key;
+	int32 Offset = 0;
+	FPropertyValuePlan Value;
+};
+
+/**
+ * Flattened description of how to read and write a `UStruct` through its reflection data.
+ *
+ * Walking `FProperty` metadata is slow, so it is only done the first time a type is used: every
+ * property is resolved to an offset, an encoding kind and its UTF-8 key, and nested structs refer
+ * to their own cached plans. Serializing then only follows the plan.
+ *
+ * @note Transient and deprecated properties are left out, as are properties of kinds that have no
+ * JSON form (object references, delegates, ...). Plans are cached for the lifetime of the module;
+ * call `ResetCache` when reflected types may have changed, e.g. after a hot reload.
+ **/
+class RAPIDJSON_API FStructPlan
+{
+public:
+	/** Returns the plan of `type`, building it on first use. Thread-safe. */
+	static const FStructPlan& Get(const UStruct* type);
+
+	/** Drops every cached plan. Must not race with serialization. */
+	static void ResetCache();
+
+	const UStruct* Type = nullptr;
+	TArray<FPropertyFieldPlan> Fields;
+};
+
+namespace Detail
+{
+template <typename WriterType>
+void WritePropertyValue(WriterType& writer, const FPropertyValuePlan& plan, const void* address);
+
+template <typename WriterType>
+void WriteStructPlan(WriterType& writer, const FStructPlan& plan, const void* const data)
+{
+	writer.StartObject();
+
+	for (const FPropertyFieldPlan& field : plan.Fields)
+	{
+		writer.Key(field.Key.GetData(), static_cast<rapidjson::SizeType>(field.Key.Num()));
+		WritePropertyValue(writer, field.Value, static_cast<const uint8*>(data) + field.Offset);
+	}
+
+	writer.EndObject();
+}
+
+template <typename WriterType>
+void WriteUtf8String(WriterType& writer, const FString& data)
+{
+	const FTCHARToUTF8 converted{ *data, data.Len() };
+	writer.String(converted.Get(), static_cast<rapidjson::SizeType>(converted.Length()));
+}
+
+/** Returns the entry of `value` among the names of an enum, or null for an unnamed value. */
+inline const FEnumPlanEntry* FindEnumEntry(const FPropertyValuePlan& plan, const int64 value)
+{
+	for (const FEnumPlanEntry& entry : plan.EnumEntries)
+	{
+		if (entry.Value == value)
+		{
+			return &entry;
+		}
+	}
+
+	return nullptr;
+}
+
+/** Map keys are written as object keys, so numbers and enums are turned into their text. */
+template <typename WriterType>
+void WriteMapKey(WriterType& writer, const FPropertyValuePlan& plan, const void* const address)
+{
+	ANSICHAR digits[24];
+	int64 number = 0;
+
+	switch (plan.Kind)
+	{
+	case EPropertyPlanKind::String:
+	{
+		const FString& key = *static_cast<const FString*>(address);
+		const FTCHARToUTF8 converted{ *key, key.Len() };
+		writer.Key(converted.Get(), static_cast<rapidjson::SizeType>(converted.Length()));
+		return;
+	}
+	case EPropertyPlanKind::Name:
+	{
+		const FNameUtf8 text = FNameCache::ToUtf8(*static_cast<const FName*>(address));
+		writer.Key(text.Data, static_cast<rapidjson::SizeType>(text.Length));
+		return;
+	}
+	case EPropertyPlanKind::Enum:
+	{
+		number = plan.Underlying->GetSignedIntPropertyValue(address);
+		if (const FEnumPlanEntry* const entry = FindEnumEntry(plan, number))
+		{
+			writer.Key(entry->Name.GetData(), static_cast<rapidjson::SizeType>(entry->Name.Num()));
+			return;
+		}
+		break;
+	}
+	case EPropertyPlanKind::UInt64:
+	{
+		const ANSICHAR* const end =
+			rapidjson::internal::u64toa(*static_cast<const uint64*>(address), digits);
+		writer.Key(digits, static_cast<rapidjson::SizeType>(end - digits));
+		return;
+	}
+	default:
+		number = static_cast<const FNumericProperty*>(plan.Property)->GetSignedIntPropertyValue(address);
+		break;
+	}
+
+	const ANSICHAR* const end = rapidjson::internal::i64toa(number, digits);
+	writer.Key(digits, static_cast<rapidjson::SizeType>(end - digits));
+}
+
+/** Integer arrays go through the writer's bulk path when it has one (see `IntegerArray`). */
+template <typename IntegerType, typename WriterType>
+auto WriteIntegerElements(WriterType& writer, FScriptArrayHelper& helper) ->
+	typename TEnableIf<Traits::WriterTraits<WriterType>::Value>::Type
+{
+	writer.IntegerArray(
+		reinterpret_cast<const IntegerType*>(helper.GetRawPtr()), static_cast<size_t>(helper.Num()));
+}
+
+template <typename IntegerType, typename WriterType>
+auto WriteIntegerElements(WriterType& writer, FScriptArrayHelper& helper) ->
+	typename TEnableIf<!Traits::WriterTraits<WriterType>::Value>::Type
+{
+	writer.StartArray();
+
+	const IntegerType* const elements = reinterpret_cast<const IntegerType*>(helper.GetRawPtr());
+	for (int32 index = 0; index < helper.Num(); ++index)
+	{
+		Serializer::ToJson(writer, elements[index]);
+	}
+
+	writer.EndArray();
+}
+
+template <typename WriterType>
+void WriteArray(WriterType& writer, const FPropertyValuePlan& plan, const void* const address)
+{
+	FScriptArrayHelper helper{ static_cast<const FArrayProperty*>(plan.Property), address };
+
+	switch (plan.Element->Kind)
+	{
+	case EPropertyPlanKind::Int8:
+		WriteIntegerElements<int8>(writer, helper);
+		return;
+	case EPropertyPlanKind::Int16:
+		WriteIntegerElements<int16>(writer, helper);
+		return;
+	case EPropertyPlanKind::Int32:
+		WriteIntegerElements<int32>(writer, helper);
+		return;
+	case EPropertyPlanKind::Int64:
+		WriteIntegerElements<int64>(writer, helper);
+		return;
+	case EPropertyPlanKind::UInt8:
+		WriteIntegerElements<uint8>(writer, helper);
+		return;
+	case EPropertyPlanKind::UInt16:
+		WriteIntegerElements<uint16>(writer, helper);
+		return;
+	case EPropertyPlanKind::UInt32:
+		WriteIntegerElements<uint32>(writer, helper);
+		return;
+	case EPropertyPlanKind::UInt64:
+		WriteIntegerElements<uint64>(writer, helper);
+		return;
+	default:
+		break;
+	}
+
+	writer.StartArray();
+
+	for (int32 index = 0; index < helper.Num(); ++index)
+	{
+		WritePropertyValue(writer, *plan.Element, helper.GetRawPtr(index));
+	}
+
+	writer.EndArray();
+}
+
+template <typename WriterType>
+void WritePropertyValue(WriterType& writer, const FPropertyValuePlan& plan, const void* const address)
+{
+	static_assert(
+		TIsSame<typename WriterType::Ch, ANSICHAR>::Value,
+		"Reflected structs are written from UTF-8 keys and strings.");
+
+	switch (plan.Kind)
+	{
+	case EPropertyPlanKind::Bool:
+		writer.Bool(static_cast<const FBoolProperty*>(plan.Property)->GetPropertyValue(address));
+		return;
+	case EPropertyPlanKind::Int8:
+		writer.Int(*static_cast<const int8*>(address));
+		return;
+	case EPropertyPlanKind::Int16:
+		writer.Int(*static_cast<const int16*>(address));
+		return;
+	case EPropertyPlanKind::Int32:
+		writer.Int(*static_cast<const int32*>(address));
+		return;
+	case EPropertyPlanKind::Int64:
+		writer.Int64(*static_cast<const int64*>(address));
+		return;
+	case EPropertyPlanKind::UInt8:
+		writer.Uint(*static_cast<const uint8*>(address));
+		return;
+	case EPropertyPlanKind::UInt16:
+		writer.Uint(*static_cast<const uint16*>(address));
+		return;
+	case EPropertyPlanKind::UInt32:
+		writer.Uint(*static_cast<const uint32*>(address));
+		return;
+	case EPropertyPlanKind::UInt64:
+		writer.Uint64(*static_cast<const uint64*>(address));
+		return;
+	case EPropertyPlanKind::Float:
+		Serializer::ToJson(writer, *static_cast<const float*>(address));
+		return;
+	case EPropertyPlanKind::Double:
+		Serializer::ToJson(writer, *static_cast<const double*>(address));
+		return;
+	case EPropertyPlanKind::Enum:
+	{
+		const int64 value = plan.Underlying->GetSignedIntPropertyValue(address);
+		if (const FEnumPlanEntry* const entry = FindEnumEntry(plan, value))
+		{
+			writer.String(entry->Name.GetData(), static_cast<rapidjson::SizeType>(entry->Name.Num()));
+		}
+		else
+		{
+			writer.Int64(value);
+		}
+		return;
+	}
+	case EPropertyPlanKind::String:
+		WriteUtf8String(writer, *static_cast<const FString*>(address));
+		return;
+	case EPropertyPlanKind::Name:
+	{
+		const FNameUtf8 text = FNameCache::ToUtf8(*static_cast<const FName*>(address));
+		writer.String(text.Data, static_cast<rapidjson::SizeType>(text.Length));
+		return;
+	}
+	case EPropertyPlanKind::Text:
+		WriteUtf8String(writer, static_cast<const FText*>(address)->ToString());
+		return;
+	case EPropertyPlanKind::Struct:
+		WriteStructPlan(writer, *plan.Struct, address);
+		return;
+	case EPropertyPlanKind::StaticArray:
+		writer.StartArray();
+		for (int32 index = 0; index < plan.ArrayDim; ++index)
+		{
+			WritePropertyValue(
+				writer, *plan.Element, static_cast<const uint8*>(address) + index * plan.ElementSize);
+		}
+		writer.EndArray();
+		return;
+	case EPropertyPlanKind::Array:
+		WriteArray(writer, plan, address);
+		return;
+	case EPropertyPlanKind::Set:
+	{
+		FScriptSetHelper helper{ static_cast<const FSetProperty*>(plan.Property), address };
+
+		writer.StartArray();
+		for (int32 index = 0; index < helper.GetMaxIndex(); ++index)
+		{
+			if (helper.IsValidIndex(index))
+			{
+				WritePropertyValue(writer, *plan.Element, helper.GetElementPtr(index));
+			}
+		}
+		writer.EndArray();
+		return;
+	}
+	case EPropertyPlanKind::Map:
+	{
+		FScriptMapHelper helper{ static_cast<const FMapProperty*>(plan.Property), address };
+
+		writer.StartObject();
+		for (int32 index = 0; index < helper.GetMaxIndex(); ++index)
+		{
+			if (helper.IsValidIndex(index))
+			{
+				WriteMapKey(writer, *plan.Element, helper.GetKeyPtr(index));
+				WritePropertyValue(writer, *plan.Value, helper.GetValuePtr(index));
+			}
+		}
+		writer.EndObject();
+		return;
+	}
+	}
+}
+} // namespace Detail
+
+/**
+ * Writes the reflected struct at `data` with any rapidjson writer taking UTF-8 input, through the
+ * cached plan of `type`.
+ **/
+template <typename WriterType>
+void WriteStruct(WriterType& writer, const UStruct* const type, const void* const data)
+{
+	Detail::WriteStructPlan(writer, FStructPlan::Get(type), data);
+}
+
+/**
+ * Serializes a `USTRUCT` (or any reflected type) that has no `JSON_DEFINE`, from its `UPROPERTY`
+ * metadata. Members are named as in C++.
+ **/
+JSON_UTILS_NODISCARD inline FString SerializeStructToJson(const UStruct* const type, const void* const data)
+{
+	JSON_UTILS_ENCODE_SCOPE();
+
+	TStringBuffer<rapidjson::UTF8<>> buffer;
+	rapidjson::Writer<decltype(buffer), rapidjson::UTF8<>, rapidjson::UTF8<>, FCrtAllocator> writer{
+		buffer
+	};
+
+	WriteStruct(writer, type, data);
+	JSON_UTILS_STAT_ADD(EncodedDocuments, 1);
+	JSON_UTILS_STAT_ADD(EncodedBytes, buffer.GetSize());
+
+	return UTF8_TO_TCHAR(buffer.GetString());
+}
+
+JSON_UTILS_NODISCARD inline FString SerializeStructToPrettyJson(
+	const UStruct* const type, const void* const data)
+{
+	JSON_UTILS_ENCODE_SCOPE();
+
+	TStringBuffer<rapidjson::UTF8<>> buffer;
+	rapidjson::PrettyWriter<decltype(buffer), rapidjson::UTF8<>, rapidjson::UTF8<>, FCrtAllocator> writer{
+		buffer
+	};
+
+	WriteStruct(writer, type, data);
+	JSON_UTILS_STAT_ADD(EncodedDocuments, 1);
+	JSON_UTILS_STAT_ADD(EncodedBytes, buffer.GetSize());
+
+	return UTF8_TO_TCHAR(buffer.GetString());
+}
+
+template <typename StructType>
+JSON_UTILS_NODISCARD FString SerializeStructToJson(const StructType& data)
+{
+	return SerializeStructToJson(StructType::StaticStruct(), &data);
+}
+
+template <typename StructType>
+JSON_UTILS_NODISCARD FString SerializeStructToPrettyJson(const StructType& data)
+{
+	return SerializeStructToPrettyJson(StructType::StaticStruct(), &data);
+}
+
+/**
+ * Decodes `json` into the reflected struct at `data`, streaming the parse events straight into
+ * its properties instead of building a document first.
+ *
+ * Members missing from `json` keep their current values and unknown members are ignored. Values
+ * of the wrong type are logged and skipped. Parse errors are reported exactly like
+ * `DeserializeFromJson`.
+ **/
+RAPIDJSON_API void DeserializeStructFromJson(const ANSICHAR* json, const UStruct* type, void* data);
+RAPIDJSON_API void DeserializeStructFromJson(const TCHAR* json, const UStruct* type, void* data);
+
+inline void DeserializeStructFromJson(const FString& json, const UStruct* const type, void* const data)
+{
+	DeserializeStructFromJson(*json, type, data);
+}
+
+template <typename StructType, typename JsonType>
+void DeserializeStructFromJson(const JsonType& json, StructType& data)
+{
+	DeserializeStructFromJson(json, StructType::StaticStruct(), &data);
+}
+
+template <typename StructType, typename JsonType>
+JSON_UTILS_NODISCARD StructType DeserializeStructFromJson(const JsonType& json)
+{
+	StructType data;
+	DeserializeStructFromJson(json, StructType::StaticStruct(), &data);
+
+	return data;
+}
+} // namespace Json
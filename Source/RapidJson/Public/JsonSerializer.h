@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cmath>
+#include <rapidjson/internal/itoa.h>
 #include "CoreMinimal.h"
+#include "JsonEnumTable.h"
 #include "JsonFwd.h"
+#include "JsonNameCache.h"
+#include "JsonNumberFormat.h"
 
 namespace Json
 {
@@ -41,32 +46,101 @@ constexpr const auto& ToJson = Detail::MakeOdrSafe<Detail::ToJsonFunctor>;
 
 namespace Detail
 {
-template <typename CharacterType> struct KeyHolder
+/** Writes ASCII text, such as digits or an enumerator, as a key in the writer's own characters. */
+template <typename WriterType>
+auto WriteAsciiKey(WriterType& writer, const ANSICHAR* const text, const int32 length) ->
+	typename TEnableIf<TIsSame<typename WriterType::Ch, ANSICHAR>::Value>::Type
 {
-};
+	writer.Key(text, static_cast<rapidjson::SizeType>(length));
+}
 
-template <> struct KeyHolder<ANSICHAR>
+template <typename WriterType>
+auto WriteAsciiKey(WriterType& writer, const ANSICHAR* const text, const int32 length) ->
+	typename TEnableIf<!TIsSame<typename WriterType::Ch, ANSICHAR>::Value>::Type
 {
-	template <typename DataType>
-	static ANSICHAR* GenerateKey(const DataType& data)
+	using CharacterType = typename WriterType::Ch;
+
+	TArray<CharacterType, TInlineAllocator<64>> characters;
+	characters.SetNumUninitialized(length);
+	for (int32 index = 0; index < length; ++index)
 	{
-		return TCHAR_TO_UTF8(*data);
+		characters[index] = static_cast<CharacterType>(text[index]);
 	}
-};
 
-template <> struct KeyHolder<TCHAR>
+	writer.Key(characters.GetData(), static_cast<rapidjson::SizeType>(length));
+}
+
+/**
+ * Map keys are written from the key itself rather than through an `FString`. Strings reach writers
+ * taking `TCHAR` input unconverted; UTF-8 writers get them through a converter on the stack, which
+ * only allocates for keys longer than its inline buffer.
+ **/
+template <typename WriterType>
+auto WriteKey(WriterType& writer, const FString& key) ->
+	typename TEnableIf<TIsSame<typename WriterType::Ch, TCHAR>::Value>::Type
 {
-	template <typename DataType>
-	static TCHAR* GenerateKey(const DataType& data)
-	{
-		return *data;
-	}
-};
+	writer.Key(*key, static_cast<rapidjson::SizeType>(key.Len()));
+}
+
+template <typename WriterType>
+auto WriteKey(WriterType& writer, const FString& key) ->
+	typename TEnableIf<TIsSame<typename WriterType::Ch, ANSICHAR>::Value>::Type
+{
+	const FTCHARToUTF8 converted{ *key, key.Len() };
+	writer.Key(converted.Get(), static_cast<rapidjson::SizeType>(converted.Length()));
+}
+
+template <typename WriterType>
+auto WriteKey(WriterType& writer, const FName& key) ->
+	typename TEnableIf<TIsSame<typename WriterType::Ch, TCHAR>::Value>::Type
+{
+	TCHAR text[NAME_SIZE];
+	const uint32 length = key.ToString(text, NAME_SIZE);
+	writer.Key(text, static_cast<rapidjson::SizeType>(length));
+}
+
+template <typename WriterType>
+auto WriteKey(WriterType& writer, const FName& key) ->
+	typename TEnableIf<TIsSame<typename WriterType::Ch, ANSICHAR>::Value>::Type
+{
+	const FNameUtf8 text = FNameCache::ToUtf8(key);
+	writer.Key(text.Data, static_cast<rapidjson::SizeType>(text.Length));
+}
+
+/** Integer keys are written as their decimal text, e.g. `{"42":...}`. */
+template <typename WriterType, typename KeyType>
+auto WriteKey(WriterType& writer, const KeyType key) ->
+	typename TEnableIf<
+	TIsIntegral<KeyType>::Value && !TIsSame<KeyType, bool>::Value && TIsSigned<KeyType>::Value>::Type
+{
+	ANSICHAR digits[24];
+	const ANSICHAR* const end = rapidjson::internal::i64toa(static_cast<int64>(key), digits);
+	WriteAsciiKey(writer, digits, static_cast<int32>(end - digits));
+}
+
+template <typename WriterType, typename KeyType>
+auto WriteKey(WriterType& writer, const KeyType key) ->
+	typename TEnableIf<
+	TIsIntegral<KeyType>::Value && !TIsSame<KeyType, bool>::Value && !TIsSigned<KeyType>::Value>::Type
+{
+	ANSICHAR digits[24];
+	const ANSICHAR* const end = rapidjson::internal::u64toa(static_cast<uint64>(key), digits);
+	WriteAsciiKey(writer, digits, static_cast<int32>(end - digits));
+}
+
+/** `JSON_MAKE_ENUM` keys are written as the enumerator's name. */
+template <typename WriterType, typename KeyType>
+auto WriteKey(WriterType& writer, const KeyType& key) ->
+	typename TEnableIf<Traits::IsBetterEnum<KeyType>::Value>::Type
+{
+	const TArray<ANSICHAR>& token = Json::Detail::TEnumNameTable<KeyType>::Get().GetToken(key);
+	WriteAsciiKey(writer, token.GetData() + 1, token.Num() - 2);
+}
 
 template <typename Writer, typename KeyType, typename ValueType>
 void InsertKeyValuePair(Writer& writer, const KeyType& key, const ValueType& value)
 {
-	writer.Key(KeyHolder<typename Writer::Ch>::GenerateKey(key));
+	WriteKey(writer, key);
 	Serializer::ToJson(writer, value);
 }
 
@@ -95,11 +169,67 @@ template <typename WriterType> void ToJson(WriterType& writer, uint64 data)
 	writer.Uint64(data);
 }
 
+/**
+ * Writes a finite `float` or `double` with the shortest text that reads back to the same value,
+ * in the precision of its own type. Other writers, and NaN and infinities, go through `Double`.
+ **/
+template <typename WriterType, typename DataType>
+auto WriteFloatingPoint(WriterType& writer, const DataType data) ->
+	typename TEnableIf<Traits::WriterTraits<WriterType>::Value>::Type
+{
+	if (!std::isfinite(data))
+	{
+		writer.Double(data);
+		return;
+	}
+
+	ANSICHAR text[NumberFormat::MaxLength];
+	const int32 length = NumberFormat::FormatShortest(data, text, writer.GetMaxDecimalPlaces());
+
+	typename WriterType::Ch raw[NumberFormat::MaxLength];
+	for (int32 index = 0; index < length; ++index)
+	{
+		raw[index] = text[index];
+	}
+
+	writer.RawValue(raw, length, rapidjson::kNumberType);
+}
+
+template <typename WriterType, typename DataType>
+auto WriteFloatingPoint(WriterType& writer, const DataType data) ->
+	typename TEnableIf<!Traits::WriterTraits<WriterType>::Value>::Type
+{
+	writer.Double(data);
+}
+
 template <typename WriterType, typename DataType>
 auto ToJson(WriterType& writer, DataType data) ->
 typename TEnableIf<TIsFloatingPoint<DataType>::Value>::Type
 {
-	writer.Double(data);
+	using FormatType = typename TChooseClass<TIsSame<DataType, float>::Value, float, double>::Result;
+	WriteFloatingPoint(writer, static_cast<FormatType>(data));
+}
+
+/**
+ * Writes a `JSON_MAKE_ENUM` value from its cached, quoted name, which rapidjson writers copy as is
+ * instead of scanning it for characters to escape.
+ **/
+template <typename WriterType, typename EnumType>
+auto WriteEnumName(WriterType& writer, const EnumType value) ->
+	typename TEnableIf<
+	Traits::WriterTraits<WriterType>::Value && TIsSame<typename WriterType::Ch, ANSICHAR>::Value>::Type
+{
+	const TArray<ANSICHAR>& token = Json::Detail::TEnumNameTable<EnumType>::Get().GetToken(value);
+	writer.RawValue(token.GetData(), static_cast<size_t>(token.Num()), rapidjson::kStringType);
+}
+
+template <typename WriterType, typename EnumType>
+auto WriteEnumName(WriterType& writer, const EnumType value) ->
+	typename TEnableIf<
+	!(Traits::WriterTraits<WriterType>::Value && TIsSame<typename WriterType::Ch, ANSICHAR>::Value)>::Type
+{
+	const TArray<ANSICHAR>& token = Json::Detail::TEnumNameTable<EnumType>::Get().GetToken(value);
+	writer.String(token.GetData() + 1, static_cast<rapidjson::SizeType>(token.Num() - 2));
 }
 
 template <typename WriterType>
@@ -111,7 +241,8 @@ void ToJson(WriterType& writer, const FString& data)
 template <typename WriterType>
 void ToJson(WriterType& writer, const FName& data)
 {
-    writer.String(TCHAR_TO_UTF8(*data.ToString()));
+	const FNameUtf8 text = FNameCache::ToUtf8(data);
+	writer.String(text.Data, static_cast<rapidjson::SizeType>(text.Length));
 }
 
 template <typename WriterType>
@@ -181,6 +312,19 @@ void ToJson(WriterType& writer, const TWeakPtr<DataType>& weakPointer)
 	ToJson(writer, *strongPointer);
 }
 
+/**
+ * Arrays of integers are handed to rapidjson writers in one call, which reserves the space for the
+ * whole array and formats the elements back to back.
+ **/
+template <typename WriterType, typename ElementType, typename AllocatorType>
+auto ToJson(WriterType& writer, const TArray<ElementType, AllocatorType>& container) ->
+typename TEnableIf<
+	Traits::WriterTraits<WriterType>::Value && TIsIntegral<ElementType>::Value &&
+	!TIsSame<ElementType, bool>::Value>::Type
+{
+	writer.IntegerArray(container.GetData(), static_cast<size_t>(container.Num()));
+}
+
 template <typename WriterType, typename ContainerType>
 auto ToJson(WriterType& writer, const ContainerType& container) ->
 typename TEnableIf<Traits::TreatAsArray<ContainerType>::Value>::Type
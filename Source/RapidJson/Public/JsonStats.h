@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Set `JSON_UTILS_STATS` to 1 (e.g. through `PublicDefinitions`) to have the plugin count what it
+ * does: allocations of its documents and string buffers, string transcodes, member lookups, and
+ * the bytes and time spent parsing and encoding. Counts are kept three ways: as the `RapidJson`
+ * stat group (`stat RapidJson`), as CPU scopes in Unreal Insights, and as totals read with
+ * `Json::GetStats`.
+ *
+ * @note Off by default, in which case the macros below expand to nothing and the allocators are
+ * plain `std::malloc` wrappers.
+ **/
+#ifndef JSON_UTILS_STATS
+#define JSON_UTILS_STATS 0
+#endif
+
+#if JSON_UTILS_STATS
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("RapidJson"), STATGROUP_RapidJson, STATCAT_Advanced);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse"), STAT_RapidJson_Parse, STATGROUP_RapidJson, RAPIDJSON_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Encode"), STAT_RapidJson_Encode, STATGROUP_RapidJson, RAPIDJSON_API);
+#endif
+
+namespace Json
+{
+enum class EStat : uint8
+{
+	/** Blocks allocated by the plugin's documents, readers and string buffers. */
+	Allocations,
+	AllocatedBytes,
+	/** Strings converted between encodings by `Deserializer::Detail::TransCode`. */
+	Transcodes,
+	TranscodedBytes,
+	/** Searches for a member by name, and the names compared while searching. */
+	MemberLookups,
+	MemberCompares,
+	ParsedDocuments,
+	ParsedBytes,
+	ParseCycles,
+	EncodedDocuments,
+	EncodedBytes,
+	EncodeCycles,
+	Count
+};
+
+/** Totals since the start, or since the last `ResetStats`. Always zero with `JSON_UTILS_STATS` off. */
+struct FStatsSnapshot
+{
+	uint64 Allocations = 0;
+	uint64 AllocatedBytes = 0;
+	uint64 Transcodes = 0;
+	uint64 TranscodedBytes = 0;
+	uint64 MemberLookups = 0;
+	uint64 MemberCompares = 0;
+	uint64 ParsedDocuments = 0;
+	uint64 ParsedBytes = 0;
+	double ParseSeconds = 0;
+	uint64 EncodedDocuments = 0;
+	uint64 EncodedBytes = 0;
+	double EncodeSeconds = 0;
+};
+
+RAPIDJSON_API FStatsSnapshot GetStats();
+RAPIDJSON_API void ResetStats();
+
+namespace Detail
+{
+RAPIDJSON_API void AddStat(EStat stat, uint64 amount);
+
+/** Adds the cycles spent in its scope to a counter. */
+class FStatTimer
+{
+public:
+	explicit FStatTimer(const EStat stat)
+		: Stat(stat)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FStatTimer()
+	{
+		AddStat(Stat, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	EStat Stat;
+	uint64 StartCycles;
+};
+} // namespace Detail
+} // namespace Json
+
+#if JSON_UTILS_STATS
+#define JSON_UTILS_STAT_ADD(Stat, Amount) \
+	::Json::Detail::AddStat(::Json::EStat::Stat, static_cast<uint64>(Amount))
+
+/** Times a parse or encode in the stat group, in Insights and in the totals. */
+#define JSON_UTILS_PARSE_SCOPE() \
+	SCOPE_CYCLE_COUNTER(STAT_RapidJson_Parse); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(RapidJson_Parse); \
+	const ::Json::Detail::FStatTimer json_utils_parse_timer{ ::Json::EStat::ParseCycles }
+
+#define JSON_UTILS_ENCODE_SCOPE() \
+	SCOPE_CYCLE_COUNTER(STAT_RapidJson_Encode); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(RapidJson_Encode); \
+	const ::Json::Detail::FStatTimer json_utils_encode_timer{ ::Json::EStat::EncodeCycles }
+#else
+#define JSON_UTILS_STAT_ADD(Stat, Amount)
+#define JSON_UTILS_PARSE_SCOPE()
+#define JSON_UTILS_ENCODE_SCOPE()
+#endif
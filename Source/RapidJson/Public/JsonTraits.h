@@ -1,5 +1,6 @@
 #pragma once
 
+#include <rapidjson/fwd.h>
 #include "FutureStd.h"
 #include "Templates/UnrealTemplate.h"
 
@@ -43,6 +44,33 @@ struct IsPair<std::pair<FirstType, SecondType>> : TrueType
 {
 };
 
+/**
+ * Key and value types stored by the pair-like element of a map container.
+ **/
+template <typename PairType> struct PairTypes
+{
+	using KeyType = typename TDecay<decltype(DeclVal<PairType&>().Key)>::Type;
+	using ValueType = typename TDecay<decltype(DeclVal<PairType&>().Value)>::Type;
+};
+
+template <typename FirstType, typename SecondType>
+struct PairTypes<std::pair<FirstType, SecondType>>
+{
+	using KeyType = typename TDecay<FirstType>::Type;
+	using ValueType = SecondType;
+};
+
+/** Detects the types declared with `JSON_MAKE_ENUM`. */
+template <typename, typename = void> struct IsBetterEnum : FalseType
+{
+};
+
+template <typename DataType>
+struct IsBetterEnum<DataType, future_std::void_t<decltype(DeclVal<const DataType&>()._to_integral())>>
+	: TrueType
+{
+};
+
 template <typename, typename = void> struct TreatAsArray : FalseType
 {
 };
@@ -72,6 +100,11 @@ struct TreatAsArray<ArrayType[ArraySize]> : TrueType
 {
 };
 
+template <typename ElementType, uint32 ArraySize, uint32 Alignment>
+struct TreatAsArray<TStaticArray<ElementType, ArraySize, Alignment>> : TrueType
+{
+};
+
 template <size_t ArraySize> struct TreatAsArray<ANSICHAR[ArraySize]> : FalseType
 {
 };
@@ -116,6 +149,51 @@ template <typename DataType> struct TreatAsValue
 		!(TreatAsArray<DataType>::Value || TreatAsObject<DataType>::Value);
 };
 
+/**
+ * Returns an address that uniquely identifies `DataType`, for keying caches by type without RTTI.
+ *
+ * @note The tag is writable on purpose: identical read-only constants may be merged into one
+ * address by identical COMDAT folding (`/OPT:ICF`, `--icf=all`), which would give several types the
+ * same id.
+ **/
+template <typename DataType> const void* TypeId()
+{
+	static uint8 tag = 0;
+	return &tag;
+}
+
+/**
+ * Exposes the encodings and flags of rapidjson's writers, so that output can be produced into a
+ * scratch buffer in exactly the same format as the destination writer would.
+ **/
+template <typename WriterType> struct WriterTraits : FalseType
+{
+};
+
+template <
+	typename OutputStreamType, typename SourceEncodingType, typename TargetEncodingType,
+	typename StackAllocatorType, unsigned WriteFlags>
+struct WriterTraits<rapidjson::Writer<
+	OutputStreamType, SourceEncodingType, TargetEncodingType, StackAllocatorType, WriteFlags>>
+	: TrueType
+{
+	using SourceEncoding = SourceEncodingType;
+	using TargetEncoding = TargetEncodingType;
+	static constexpr unsigned Flags = WriteFlags;
+};
+
+template <
+	typename OutputStreamType, typename SourceEncodingType, typename TargetEncodingType,
+	typename StackAllocatorType, unsigned WriteFlags>
+struct WriterTraits<rapidjson::PrettyWriter<
+	OutputStreamType, SourceEncodingType, TargetEncodingType, StackAllocatorType, WriteFlags>>
+	: TrueType
+{
+	using SourceEncoding = SourceEncodingType;
+	using TargetEncoding = TargetEncodingType;
+	static constexpr unsigned Flags = WriteFlags;
+};
+
 template <typename, typename, typename = void> struct HasToJson : FalseType
 {
 };
@@ -138,5 +216,55 @@ struct HasFromJson<
 {
 };
 
+/**
+ * Stand-in visitor used to detect the `VisitJsonFields` functions generated by `JSON_DEFINE` and
+ * `JSON_EXTERNAL_DEFINE`.
+ **/
+struct FieldVisitorArchetype
+{
+	template <typename MemberPointerType>
+	void operator()(const ANSICHAR* name, MemberPointerType member) const;
+};
+
+template <typename, typename = void> struct HasMemberJsonFields : FalseType
+{
+};
+
+template <typename DataType>
+struct HasMemberJsonFields<
+	DataType, future_std::void_t<decltype(DeclVal<const DataType&>()
+		.VisitJsonFields(DeclVal<FieldVisitorArchetype&>()))>> : TrueType
+{
+};
+
+template <typename, typename = void> struct HasExternalJsonFields : FalseType
+{
+};
+
+template <typename DataType>
+struct HasExternalJsonFields<
+	DataType, future_std::void_t<decltype(VisitJsonFields(
+		DeclVal<const DataType&>(), DeclVal<FieldVisitorArchetype&>()))>> : TrueType
+{
+};
+
+/** Whether the type's fields were listed with `JSON_DEFINE` or `JSON_EXTERNAL_DEFINE`. */
+template <typename DataType> struct HasJsonFields
+{
+	static constexpr bool Value =
+		HasMemberJsonFields<DataType>::Value || HasExternalJsonFields<DataType>::Value;
+};
+
+template <typename, typename = void> struct HasEqualityOperator : FalseType
+{
+};
+
+template <typename DataType>
+struct HasEqualityOperator<
+	DataType, future_std::void_t<decltype(DeclVal<const DataType&>() == DeclVal<const DataType&>())>>
+	: TrueType
+{
+};
+
 } // namespace Traits
 } // namespace Json
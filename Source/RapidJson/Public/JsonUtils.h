@@ -1,31 +1,76 @@
 #pragma once
 
 #include "RapidJsonPCH.h"
+#include "JsonAllocator.h"
 #include "JsonDeserializer.h"
 #include "JsonSerializer.h"
+#include "JsonFields.h"
+#include "JsonFieldTable.h"
+#include "JsonParseError.h"
 #include "FutureStd.h"
 
 namespace Json
 {
 namespace Detail
 {
-template <typename ContainerType, typename EncodingType, typename StreamType>
-ContainerType Deserialize(StreamType& stream)
+/**
+ * Parses `stream` into `document`, logging and throwing `std::invalid_argument` on failure.
+ *
+ * @param source The null-terminated text behind `stream`, if available. It is only read again
+ * after a parse failure, to turn the error offset into a line, column and snippet.
+ **/
+template <typename DocumentType, typename StreamType>
+void ParseOrThrow(
+	DocumentType& document, StreamType& stream, const typename DocumentType::Ch* const source = nullptr)
 {
-	rapidjson::GenericDocument<EncodingType> document;
+	JSON_UTILS_PARSE_SCOPE();
+
 	document.ParseStream(stream);
+	JSON_UTILS_STAT_ADD(ParsedDocuments, 1);
+	JSON_UTILS_STAT_ADD(ParsedBytes, stream.Tell() * sizeof(typename DocumentType::Ch));
 
 	if (document.HasParseError())
 	{
-		throw std::invalid_argument("Could not parse JSON document.");
+		const FString message = DescribeParseError(document, source);
+		UE_LOG(LogRapidJson, Error, TEXT("Could not parse JSON document: %s"), *message);
+		throw std::invalid_argument(TCHAR_TO_UTF8(*message));
 	}
+}
+
+/**
+ * Parses `stream` and decodes the document into `data`.
+ *
+ * @param length The number of characters of `source`, or 0 when unknown. The values of a parsed
+ * document take about as much memory as its text, so a known length sizes the document's allocator
+ * up front.
+ **/
+template <typename DataType, typename EncodingType, typename StreamType>
+void DeserializeInto(
+	StreamType& stream, DataType& data, const typename EncodingType::Ch* const source = nullptr,
+	const SIZE_T length = 0)
+{
+	TDocument<EncodingType> document;
+	if (length != 0)
+	{
+		document.GetAllocator().Reserve(length * sizeof(typename EncodingType::Ch));
+	}
+
+	ParseOrThrow(document, stream, source);
+
+	Deserializer::FromJson(document, data);
+}
 
+template <typename ContainerType, typename EncodingType, typename StreamType>
+ContainerType Deserialize(
+	StreamType& stream, const typename EncodingType::Ch* const source = nullptr,
+	const SIZE_T length = 0)
+{
 	static_assert(
 		TIsConstructible<ContainerType>::Value,
 		"The container must have a default constructible.");
 
 	ContainerType container;
-	Deserializer::FromJson(document, container);
+	DeserializeInto<ContainerType, EncodingType>(stream, container, source, length);
 
 	return container;
 }
@@ -36,10 +81,16 @@ template <
 	typename DataType>
 JSON_UTILS_NODISCARD FString SerializeToJson(const DataType& data)
 {
-	rapidjson::GenericStringBuffer<OutputEncodingType> buffer;
-	rapidjson::Writer<decltype(buffer), InputEncodingType, OutputEncodingType> writer{ buffer };
+	JSON_UTILS_ENCODE_SCOPE();
+
+	TStringBuffer<OutputEncodingType> buffer;
+	rapidjson::Writer<decltype(buffer), InputEncodingType, OutputEncodingType, FCrtAllocator> writer{
+		buffer
+	};
 
 	Serializer::ToJson(writer, data);
+	JSON_UTILS_STAT_ADD(EncodedDocuments, 1);
+	JSON_UTILS_STAT_ADD(EncodedBytes, buffer.GetSize());
 
 	return buffer.GetString();
 }
@@ -49,12 +100,16 @@ template <
 	typename DataType>
 JSON_UTILS_NODISCARD FString SerializeToPrettyJson(const DataType& data)
 {
-	rapidjson::GenericStringBuffer<OutputEncodingType> buffer;
-	rapidjson::PrettyWriter<decltype(buffer), InputEncodingType, OutputEncodingType> writer{
+	JSON_UTILS_ENCODE_SCOPE();
+
+	TStringBuffer<OutputEncodingType> buffer;
+	rapidjson::PrettyWriter<decltype(buffer), InputEncodingType, OutputEncodingType, FCrtAllocator> writer{
 		buffer
 	};
 
 	Serializer::ToJson(writer, data);
+	JSON_UTILS_STAT_ADD(EncodedDocuments, 1);
+	JSON_UTILS_STAT_ADD(EncodedBytes, buffer.GetSize());
 
 	return buffer.GetString();
 }
@@ -65,7 +120,7 @@ JSON_UTILS_NODISCARD ContainerType DeserializeFromJson(const ANSICHAR* const jso
 	using EncodingType = rapidjson::UTF8<>;
 
 	rapidjson::GenericStringStream<EncodingType> string_stream{ json };
-	return Detail::Deserialize<ContainerType, EncodingType>(string_stream);
+	return Detail::Deserialize<ContainerType, EncodingType>(string_stream, json);
 }
 
 template <typename ContainerType>
@@ -74,13 +129,48 @@ JSON_UTILS_NODISCARD ContainerType DeserializeFromJson(const TCHAR* const json)
 	using EncodingType = rapidjson::UTF16<>;
 
 	rapidjson::GenericStringStream<EncodingType> string_stream{ json };
-	return Detail::Deserialize<ContainerType, EncodingType>(string_stream);
+	return Detail::Deserialize<ContainerType, EncodingType>(string_stream, json);
 }
 
 template <typename ContainerType>
 JSON_UTILS_NODISCARD ContainerType DeserializeFromJson(const FString& json)
 {
-	return DeserializeFromJson<ContainerType>(*json);
+	using EncodingType = rapidjson::UTF16<>;
+
+	rapidjson::GenericStringStream<EncodingType> string_stream{ *json };
+	return Detail::Deserialize<ContainerType, EncodingType>(string_stream, *json, json.Len());
+}
+
+/**
+ * Decodes `json` into an existing object instead of a fresh one. Arrays, maps and strings are
+ * overwritten in place, so their allocations are reused when the same object is decoded over and
+ * over (e.g. when applying periodic state updates).
+ **/
+template <typename DataType>
+void DeserializeFromJson(const ANSICHAR* const json, DataType& data)
+{
+	using EncodingType = rapidjson::UTF8<>;
+
+	rapidjson::GenericStringStream<EncodingType> string_stream{ json };
+	Detail::DeserializeInto<DataType, EncodingType>(string_stream, data, json);
+}
+
+template <typename DataType>
+void DeserializeFromJson(const TCHAR* const json, DataType& data)
+{
+	using EncodingType = rapidjson::UTF16<>;
+
+	rapidjson::GenericStringStream<EncodingType> string_stream{ json };
+	Detail::DeserializeInto<DataType, EncodingType>(string_stream, data, json);
+}
+
+template <typename DataType>
+void DeserializeFromJson(const FString& json, DataType& data)
+{
+	using EncodingType = rapidjson::UTF16<>;
+
+	rapidjson::GenericStringStream<EncodingType> string_stream{ *json };
+	Detail::DeserializeInto<DataType, EncodingType>(string_stream, data, *json, json.Len());
 }
 
 } // namespace Json
@@ -0,0 +1,984 @@
+#pragma once
+
+#include <type_traits>
+#include "CoreMinimal.h"
+#include "Algo/Reverse.h"
+#include "JsonDelta.h"
+#include "JsonHash.h"
+#include "JsonMemoized.h"
+#include "JsonMessagePack.h"
+
+namespace Json
+{
+/**
+ * Compact binary encoding bound to the field lists of `JSON_DEFINE` and `JSON_EXTERNAL_DEFINE`.
+ *
+ * The same declaration that drives `SerializeToJson` drives this format, so a type can be logged
+ * as JSON and replicated in binary. Instead of key strings each field is introduced by the
+ * distance to the previous field's ordinal (one byte in practice), and fields still holding their
+ * default value are left out. Integers are varints (zigzag for signed types), floating point
+ * values are stored raw and strings as length-prefixed UTF-8.
+ *
+ * Messages start with a fingerprint of the schema (field names and types, recursively), which
+ * the decoder checks before reading anything else.
+ *
+ * @note Types with a custom `ToJson`/`FromJson` but no field list are embedded as MessagePack.
+ **/
+namespace Wire
+{
+class FWriter
+{
+public:
+	explicit FWriter(TArray<uint8>& output)
+		: Output(output)
+	{
+	}
+
+	void WriteVarint(uint64 value)
+	{
+		while (value >= 0x80)
+		{
+			Output.Add(static_cast<uint8>(value | 0x80));
+			value >>= 7;
+		}
+		Output.Add(static_cast<uint8>(value));
+	}
+
+	void WriteSigned(const int64 value)
+	{
+		WriteVarint((static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63));
+	}
+
+	void WriteBytes(const void* data, const int32 size)
+	{
+		Output.Append(static_cast<const uint8*>(data), size);
+	}
+
+	/** Writes a fixed-size value in little-endian order. */
+	template <typename DataType>
+	void WriteFixed(const DataType& value)
+	{
+		uint8 bytes[sizeof(DataType)];
+		FMemory::Memcpy(bytes, &value, sizeof(DataType));
+#if !PLATFORM_LITTLE_ENDIAN
+		Algo::Reverse(bytes);
+#endif
+		WriteBytes(bytes, sizeof(DataType));
+	}
+
+	TArray<uint8>& GetOutput()
+	{
+		return Output;
+	}
+
+private:
+	TArray<uint8>& Output;
+};
+
+class FReader
+{
+public:
+	FReader(const uint8* data, const SIZE_T size)
+		: Begin(data)
+		, Cursor(data)
+		, End(data + size)
+	{
+	}
+
+	bool ReadVarint(uint64& value)
+	{
+		value = 0;
+		for (int32 shift = 0; shift < 64; shift += 7)
+		{
+			if (Cursor == End)
+			{
+				return false;
+			}
+
+			const uint8 byte = *Cursor++;
+			// The tenth byte only has room for bit 63, anything more would be silently dropped.
+			if (shift == 63 && byte > 1)
+			{
+				return false;
+			}
+
+			value |= static_cast<uint64>(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool ReadSigned(int64& value)
+	{
+		uint64 encoded;
+		if (!ReadVarint(encoded))
+		{
+			return false;
+		}
+
+		value = static_cast<int64>(encoded >> 1) ^ -static_cast<int64>(encoded & 1);
+		return true;
+	}
+
+	/** Reads an element count, rejecting counts larger than the remaining data could hold. */
+	bool ReadCount(int32& count)
+	{
+		uint64 value;
+		if (!ReadVarint(value) || value > Remaining())
+		{
+			return false;
+		}
+
+		count = static_cast<int32>(value);
+		return true;
+	}
+
+	const uint8* ReadBytes(const SIZE_T size)
+	{
+		if (size > Remaining())
+		{
+			return nullptr;
+		}
+
+		const uint8* const bytes = Cursor;
+		Cursor += size;
+		return bytes;
+	}
+
+	template <typename DataType>
+	bool ReadFixed(DataType& value)
+	{
+		const uint8* const bytes = ReadBytes(sizeof(DataType));
+		if (bytes == nullptr)
+		{
+			return false;
+		}
+
+		uint8 ordered[sizeof(DataType)];
+		FMemory::Memcpy(ordered, bytes, sizeof(DataType));
+#if !PLATFORM_LITTLE_ENDIAN
+		Algo::Reverse(ordered);
+#endif
+		FMemory::Memcpy(&value, ordered, sizeof(DataType));
+		return true;
+	}
+
+	SIZE_T Remaining() const
+	{
+		return static_cast<SIZE_T>(End - Cursor);
+	}
+
+	SIZE_T GetOffset() const
+	{
+		return static_cast<SIZE_T>(Cursor - Begin);
+	}
+
+private:
+	const uint8* Begin;
+	const uint8* Cursor;
+	const uint8* End;
+};
+
+namespace Detail
+{
+/** Fingerprint tags of the built-in encodings; changing any of them breaks compatibility. */
+enum class ETag : uint64
+{
+	Bool = 1,
+	Signed,
+	Unsigned,
+	Float,
+	Double,
+	String,
+	Optional,
+	Array,
+	FixedArray,
+	Set,
+	Map,
+	Object,
+	Embedded,
+	Recursive
+};
+
+inline uint64 TagHash(const ETag tag, const uint64 detail = 0)
+{
+	return Json::Detail::HashCombine64(static_cast<uint64>(tag), detail);
+}
+} // namespace Detail
+
+/**
+ * Encoding of one type. Specializations provide `Write`, `Read` (returning false on malformed
+ * data) and `Fingerprint`; the primary template embeds the type as MessagePack.
+ **/
+template <typename DataType, typename = void> struct TCodec
+{
+	static void Write(FWriter& writer, const DataType& data)
+	{
+		TArray<uint8> embedded;
+		FMessagePackWriter embedded_writer{ embedded };
+		Serializer::ToJson(embedded_writer, data);
+
+		writer.WriteVarint(static_cast<uint64>(embedded.Num()));
+		writer.WriteBytes(embedded.GetData(), embedded.Num());
+	}
+
+	static bool Read(FReader& reader, DataType& data)
+	{
+		uint64 size;
+		if (!reader.ReadVarint(size))
+		{
+			return false;
+		}
+
+		const uint8* const bytes = reader.ReadBytes(static_cast<SIZE_T>(size));
+		if (bytes == nullptr)
+		{
+			return false;
+		}
+
+		Json::Detail::DeserializeMessagePackInto(bytes, static_cast<SIZE_T>(size), data);
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Embedded);
+	}
+};
+
+template <> struct TCodec<bool>
+{
+	static void Write(FWriter& writer, const bool data)
+	{
+		writer.WriteVarint(data ? 1 : 0);
+	}
+
+	static bool Read(FReader& reader, bool& data)
+	{
+		uint64 value;
+		if (!reader.ReadVarint(value) || value > 1)
+		{
+			return false;
+		}
+
+		data = value != 0;
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Bool);
+	}
+};
+
+template <typename DataType>
+struct TCodec<
+	DataType, typename TEnableIf<
+	std::is_integral<DataType>::value && std::is_signed<DataType>::value>::Type>
+{
+	static void Write(FWriter& writer, const DataType data)
+	{
+		writer.WriteSigned(static_cast<int64>(data));
+	}
+
+	static bool Read(FReader& reader, DataType& data)
+	{
+		int64 value;
+		if (!reader.ReadSigned(value) || static_cast<int64>(static_cast<DataType>(value)) != value)
+		{
+			return false;
+		}
+
+		data = static_cast<DataType>(value);
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Signed, sizeof(DataType));
+	}
+};
+
+template <typename DataType>
+struct TCodec<
+	DataType, typename TEnableIf<
+	std::is_integral<DataType>::value && !std::is_signed<DataType>::value &&
+	!TIsSame<DataType, bool>::Value>::Type>
+{
+	static void Write(FWriter& writer, const DataType data)
+	{
+		writer.WriteVarint(static_cast<uint64>(data));
+	}
+
+	static bool Read(FReader& reader, DataType& data)
+	{
+		uint64 value;
+		if (!reader.ReadVarint(value) || static_cast<uint64>(static_cast<DataType>(value)) != value)
+		{
+			return false;
+		}
+
+		data = static_cast<DataType>(value);
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Unsigned, sizeof(DataType));
+	}
+};
+
+template <typename DataType>
+struct TCodec<DataType, typename TEnableIf<std::is_floating_point<DataType>::value>::Type>
+{
+	static void Write(FWriter& writer, const DataType data)
+	{
+		writer.WriteFixed(data);
+	}
+
+	static bool Read(FReader& reader, DataType& data)
+	{
+		return reader.ReadFixed(data);
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(
+			sizeof(DataType) == sizeof(float) ? Detail::ETag::Float : Detail::ETag::Double);
+	}
+};
+
+template <typename DataType>
+struct TCodec<DataType, typename TEnableIf<std::is_enum<DataType>::value>::Type>
+{
+	using UnderlyingType = typename std::underlying_type<DataType>::type;
+
+	static void Write(FWriter& writer, const DataType data)
+	{
+		TCodec<UnderlyingType>::Write(writer, static_cast<UnderlyingType>(data));
+	}
+
+	static bool Read(FReader& reader, DataType& data)
+	{
+		UnderlyingType value;
+		if (!TCodec<UnderlyingType>::Read(reader, value))
+		{
+			return false;
+		}
+
+		data = static_cast<DataType>(value);
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return TCodec<UnderlyingType>::Fingerprint();
+	}
+};
+
+/** `JSON_MAKE_ENUM` values travel as their integral value rather than their name. */
+template <typename DataType>
+struct TCodec<DataType, typename TEnableIf<Traits::IsBetterEnum<DataType>::Value>::Type>
+{
+	using IntegralType = typename DataType::_integral;
+
+	static void Write(FWriter& writer, const DataType& data)
+	{
+		TCodec<IntegralType>::Write(writer, data._to_integral());
+	}
+
+	static bool Read(FReader& reader, DataType& data)
+	{
+		IntegralType value;
+		if (!TCodec<IntegralType>::Read(reader, value) || !DataType::_is_valid(value))
+		{
+			return false;
+		}
+
+		data = DataType::_from_integral_unchecked(value);
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return TCodec<IntegralType>::Fingerprint();
+	}
+};
+
+template <> struct TCodec<FString>
+{
+	static void Write(FWriter& writer, const FString& data)
+	{
+		const FTCHARToUTF8 converted{ *data, data.Len() };
+		writer.WriteVarint(static_cast<uint64>(converted.Length()));
+		writer.WriteBytes(converted.Get(), converted.Length());
+	}
+
+	static bool Read(FReader& reader, FString& data)
+	{
+		uint64 size;
+		if (!reader.ReadVarint(size))
+		{
+			return false;
+		}
+
+		const uint8* const bytes = reader.ReadBytes(static_cast<SIZE_T>(size));
+		if (bytes == nullptr)
+		{
+			return false;
+		}
+
+		Deserializer::Detail::AssignString(
+			reinterpret_cast<const ANSICHAR*>(bytes), static_cast<rapidjson::SizeType>(size), data);
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::String);
+	}
+};
+
+template <> struct TCodec<FName>
+{
+	static void Write(FWriter& writer, const FName& data)
+	{
+		TCodec<FString>::Write(writer, data.ToString());
+	}
+
+	static bool Read(FReader& reader, FName& data)
+	{
+		FString value;
+		if (!TCodec<FString>::Read(reader, value))
+		{
+			return false;
+		}
+
+		data = FName(*value);
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return TCodec<FString>::Fingerprint();
+	}
+};
+
+template <> struct TCodec<FText>
+{
+	static void Write(FWriter& writer, const FText& data)
+	{
+		TCodec<FString>::Write(writer, data.ToString());
+	}
+
+	static bool Read(FReader& reader, FText& data)
+	{
+		FString value;
+		if (!TCodec<FString>::Read(reader, value))
+		{
+			return false;
+		}
+
+		data = FText::FromString(MoveTemp(value));
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return TCodec<FString>::Fingerprint();
+	}
+};
+
+template <typename ElementType> struct TCodec<TOptional<ElementType>>
+{
+	static void Write(FWriter& writer, const TOptional<ElementType>& data)
+	{
+		writer.WriteVarint(data.IsSet() ? 1 : 0);
+		if (data.IsSet())
+		{
+			TCodec<ElementType>::Write(writer, data.GetValue());
+		}
+	}
+
+	static bool Read(FReader& reader, TOptional<ElementType>& data)
+	{
+		bool is_set;
+		if (!TCodec<bool>::Read(reader, is_set))
+		{
+			return false;
+		}
+
+		if (!is_set)
+		{
+			data.Reset();
+			return true;
+		}
+
+		if (!data.IsSet())
+		{
+			data.Emplace();
+		}
+
+		return TCodec<ElementType>::Read(reader, data.GetValue());
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Optional, TCodec<ElementType>::Fingerprint());
+	}
+};
+
+template <typename ElementType> struct TCodec<TSharedPtr<ElementType>>
+{
+	static void Write(FWriter& writer, const TSharedPtr<ElementType>& data)
+	{
+		writer.WriteVarint(data.IsValid() ? 1 : 0);
+		if (data.IsValid())
+		{
+			TCodec<ElementType>::Write(writer, *data);
+		}
+	}
+
+	static bool Read(FReader& reader, TSharedPtr<ElementType>& data)
+	{
+		bool is_valid;
+		if (!TCodec<bool>::Read(reader, is_valid))
+		{
+			return false;
+		}
+
+		if (!is_valid)
+		{
+			data.Reset();
+			return true;
+		}
+
+		// The pointee may be shared with other owners, so decode into a fresh object.
+		data = MakeShared<ElementType>();
+		return TCodec<ElementType>::Read(reader, *data);
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Optional, TCodec<ElementType>::Fingerprint());
+	}
+};
+
+template <typename ElementType> struct TCodec<TUniquePtr<ElementType>>
+{
+	static void Write(FWriter& writer, const TUniquePtr<ElementType>& data)
+	{
+		writer.WriteVarint(data.IsValid() ? 1 : 0);
+		if (data.IsValid())
+		{
+			TCodec<ElementType>::Write(writer, *data);
+		}
+	}
+
+	static bool Read(FReader& reader, TUniquePtr<ElementType>& data)
+	{
+		bool is_valid;
+		if (!TCodec<bool>::Read(reader, is_valid))
+		{
+			return false;
+		}
+
+		if (!is_valid)
+		{
+			data.Reset();
+			return true;
+		}
+
+		if (!data.IsValid())
+		{
+			data = MakeUnique<ElementType>();
+		}
+
+		return TCodec<ElementType>::Read(reader, *data);
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Optional, TCodec<ElementType>::Fingerprint());
+	}
+};
+
+template <typename ElementType, typename AllocatorType>
+struct TCodec<TArray<ElementType, AllocatorType>>
+{
+	static void Write(FWriter& writer, const TArray<ElementType, AllocatorType>& data)
+	{
+		writer.WriteVarint(static_cast<uint64>(data.Num()));
+		for (const ElementType& element : data)
+		{
+			TCodec<ElementType>::Write(writer, element);
+		}
+	}
+
+	static bool Read(FReader& reader, TArray<ElementType, AllocatorType>& data)
+	{
+		int32 count;
+		if (!reader.ReadCount(count))
+		{
+			return false;
+		}
+
+		data.SetNum(count, false);
+		for (ElementType& element : data)
+		{
+			if (!TCodec<ElementType>::Read(reader, element))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Array, TCodec<ElementType>::Fingerprint());
+	}
+};
+
+template <typename ElementType, uint32 ArraySize, uint32 Alignment>
+struct TCodec<TStaticArray<ElementType, ArraySize, Alignment>>
+{
+	static void Write(FWriter& writer, const TStaticArray<ElementType, ArraySize, Alignment>& data)
+	{
+		for (uint32 index = 0; index < ArraySize; ++index)
+		{
+			TCodec<ElementType>::Write(writer, data[index]);
+		}
+	}
+
+	static bool Read(FReader& reader, TStaticArray<ElementType, ArraySize, Alignment>& data)
+	{
+		for (uint32 index = 0; index < ArraySize; ++index)
+		{
+			if (!TCodec<ElementType>::Read(reader, data[index]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(
+			Detail::ETag::FixedArray, Json::Detail::HashCombine64(TCodec<ElementType>::Fingerprint(), ArraySize));
+	}
+};
+
+template <typename ElementType, size_t ArraySize> struct TCodec<ElementType[ArraySize]>
+{
+	static void Write(FWriter& writer, const ElementType (&data)[ArraySize])
+	{
+		for (const ElementType& element : data)
+		{
+			TCodec<ElementType>::Write(writer, element);
+		}
+	}
+
+	static bool Read(FReader& reader, ElementType (&data)[ArraySize])
+	{
+		for (ElementType& element : data)
+		{
+			if (!TCodec<ElementType>::Read(reader, element))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(
+			Detail::ETag::FixedArray, Json::Detail::HashCombine64(TCodec<ElementType>::Fingerprint(), ArraySize));
+	}
+};
+
+template <typename ElementType, typename KeyFuncsType, typename AllocatorType>
+struct TCodec<TSet<ElementType, KeyFuncsType, AllocatorType>>
+{
+	static void Write(FWriter& writer, const TSet<ElementType, KeyFuncsType, AllocatorType>& data)
+	{
+		writer.WriteVarint(static_cast<uint64>(data.Num()));
+		for (const ElementType& element : data)
+		{
+			TCodec<ElementType>::Write(writer, element);
+		}
+	}
+
+	static bool Read(FReader& reader, TSet<ElementType, KeyFuncsType, AllocatorType>& data)
+	{
+		int32 count;
+		if (!reader.ReadCount(count))
+		{
+			return false;
+		}
+
+		data.Reset();
+		data.Reserve(count);
+		for (int32 index = 0; index < count; ++index)
+		{
+			ElementType element{};
+			if (!TCodec<ElementType>::Read(reader, element))
+			{
+				return false;
+			}
+			data.Emplace(MoveTemp(element));
+		}
+
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(Detail::ETag::Set, TCodec<ElementType>::Fingerprint());
+	}
+};
+
+template <typename KeyType, typename ValueType, typename SetAllocatorType, typename KeyFuncsType>
+struct TCodec<TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>>
+{
+	using MapType = TMap<KeyType, ValueType, SetAllocatorType, KeyFuncsType>;
+
+	static void Write(FWriter& writer, const MapType& data)
+	{
+		writer.WriteVarint(static_cast<uint64>(data.Num()));
+		for (const auto& pair : data)
+		{
+			TCodec<KeyType>::Write(writer, pair.Key);
+			TCodec<ValueType>::Write(writer, pair.Value);
+		}
+	}
+
+	static bool Read(FReader& reader, MapType& data)
+	{
+		int32 count;
+		if (!reader.ReadCount(count))
+		{
+			return false;
+		}
+
+		data.Reset();
+		data.Reserve(count);
+		for (int32 index = 0; index < count; ++index)
+		{
+			KeyType key{};
+			if (!TCodec<KeyType>::Read(reader, key) ||
+				!TCodec<ValueType>::Read(reader, data.Emplace(MoveTemp(key))))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static uint64 Fingerprint()
+	{
+		return Detail::TagHash(
+			Detail::ETag::Map,
+			Json::Detail::HashCombine64(TCodec<KeyType>::Fingerprint(), TCodec<ValueType>::Fingerprint()));
+	}
+};
+
+template <typename ElementType> struct TCodec<TMemoized<ElementType>>
+{
+	static void Write(FWriter& writer, const TMemoized<ElementType>& data)
+	{
+		TCodec<ElementType>::Write(writer, data.Get());
+	}
+
+	static bool Read(FReader& reader, TMemoized<ElementType>& data)
+	{
+		return TCodec<ElementType>::Read(reader, *data.Edit());
+	}
+
+	static uint64 Fingerprint()
+	{
+		return TCodec<ElementType>::Fingerprint();
+	}
+};
+
+/**
+ * Defined types write `ordinal - previous ordinal` before each non-default field and a zero
+ * after the last one. Fields missing from the message are reset to their default value.
+ **/
+template <typename DataType>
+struct TCodec<DataType, typename TEnableIf<Traits::HasJsonFields<DataType>::Value>::Type>
+{
+	static_assert(
+		TIsConstructible<DataType>::Value,
+		"Wire format types must be default constructible, defaults are omitted from messages.");
+
+	static const DataType& Defaults()
+	{
+		static const DataType defaults{};
+		return defaults;
+	}
+
+	static void Write(FWriter& writer, const DataType& data)
+	{
+		const DataType& defaults = Defaults();
+		uint64 ordinal = 0;
+		uint64 previous_ordinal = 0;
+
+		Json::Detail::VisitFields(data, [&](const ANSICHAR*, auto member) {
+			++ordinal;
+			if (!Json::Detail::JsonEquals(data.*member, defaults.*member))
+			{
+				writer.WriteVarint(ordinal - previous_ordinal);
+				WriteField(writer, data.*member);
+				previous_ordinal = ordinal;
+			}
+		});
+
+		writer.WriteVarint(0);
+	}
+
+	static bool Read(FReader& reader, DataType& data)
+	{
+		const DataType& defaults = Defaults();
+		uint64 ordinal = 0;
+		uint64 distance = 0;
+		bool succeeded = reader.ReadVarint(distance);
+		uint64 next_ordinal = distance;
+
+		Json::Detail::VisitFields(defaults, [&](const ANSICHAR*, auto member) {
+			++ordinal;
+			if (!succeeded)
+			{
+				return;
+			}
+
+			if (ordinal != next_ordinal)
+			{
+				data.*member = defaults.*member;
+				return;
+			}
+
+			succeeded = ReadField(reader, data.*member) && reader.ReadVarint(distance);
+			next_ordinal = distance == 0 ? 0 : ordinal + distance;
+		});
+
+		// A field ordinal past the last field means the schemas disagree.
+		return succeeded && next_ordinal == 0;
+	}
+
+	static uint64 Fingerprint()
+	{
+		// Self-referencing types (e.g. trees built from TSharedPtr) would otherwise recurse forever.
+		static thread_local bool in_progress = false;
+		if (in_progress)
+		{
+			return Detail::TagHash(Detail::ETag::Recursive);
+		}
+
+		in_progress = true;
+		uint64 fingerprint = Detail::TagHash(Detail::ETag::Object);
+		Json::Detail::VisitFields(Defaults(), [&](const ANSICHAR* name, auto member) {
+			using FieldType = typename TDecay<decltype(Defaults().*member)>::Type;
+			fingerprint = Json::Detail::HashCombine64(
+				fingerprint,
+				Json::Detail::HashCombine64(
+					Json::Detail::HashBytes(name, FCStringAnsi::Strlen(name)),
+					TCodec<FieldType>::Fingerprint()));
+		});
+		in_progress = false;
+
+		return fingerprint;
+	}
+
+private:
+	template <typename FieldType>
+	static void WriteField(FWriter& writer, const FieldType& field)
+	{
+		TCodec<FieldType>::Write(writer, field);
+	}
+
+	template <typename FieldType>
+	static bool ReadField(FReader& reader, FieldType& field)
+	{
+		return TCodec<FieldType>::Read(reader, field);
+	}
+};
+} // namespace Wire
+
+/** Fingerprint written at the start of every wire format message for `DataType`. */
+template <typename DataType>
+uint64 GetWireFormatFingerprint()
+{
+	static const uint64 fingerprint = Wire::TCodec<DataType>::Fingerprint();
+	return fingerprint;
+}
+
+template <typename DataType>
+JSON_UTILS_NODISCARD TArray<uint8> SerializeToWireFormat(const DataType& data)
+{
+	TArray<uint8> buffer;
+	Wire::FWriter writer{ buffer };
+
+	writer.WriteFixed(GetWireFormatFingerprint<DataType>());
+	Wire::TCodec<DataType>::Write(writer, data);
+
+	return buffer;
+}
+
+/**
+ * Decodes a wire format message into an existing object, reusing its allocations. A fingerprint
+ * mismatch or malformed data is logged and reported by throwing `std::invalid_argument`.
+ **/
+template <typename DataType>
+void DeserializeFromWireFormat(const uint8* const data, const SIZE_T size, DataType& output)
+{
+	Wire::FReader reader{ data, size };
+
+	uint64 fingerprint = 0;
+	if (!reader.ReadFixed(fingerprint) || fingerprint != GetWireFormatFingerprint<DataType>())
+	{
+		UE_LOG(
+			LogRapidJson, Error,
+			TEXT("Wire format message was written for a different schema (fingerprint %016llx)."),
+			static_cast<unsigned long long>(fingerprint));
+		throw std::invalid_argument("Wire format schema mismatch.");
+	}
+
+	if (!Wire::TCodec<DataType>::Read(reader, output) || reader.Remaining() != 0)
+	{
+		UE_LOG(
+			LogRapidJson, Error, TEXT("Malformed wire format message (offset %llu)."),
+			static_cast<unsigned long long>(reader.GetOffset()));
+		throw std::invalid_argument("Malformed wire format message.");
+	}
+}
+
+template <typename DataType>
+void DeserializeFromWireFormat(const TArray<uint8>& data, DataType& output)
+{
+	DeserializeFromWireFormat(data.GetData(), static_cast<SIZE_T>(data.Num()), output);
+}
+
+template <typename ContainerType>
+JSON_UTILS_NODISCARD ContainerType DeserializeFromWireFormat(const TArray<uint8>& data)
+{
+	static_assert(
+		TIsConstructible<ContainerType>::Value,
+		"The container must have a default constructible.");
+
+	ContainerType container;
+	DeserializeFromWireFormat(data, container);
+
+	return container;
+}
+} // namespace Json
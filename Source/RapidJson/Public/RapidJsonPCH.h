@@ -21,86 +21,128 @@ THIRD_PARTY_INCLUDES_START
 THIRD_PARTY_INCLUDES_END
 
 #define EXPAND(x) x
+// One FOR_EACH_N per field count. 63 fields is the most that FOR_EACH_NARG can count, as MSVC
+// accepts no more than 127 arguments in a macro invocation.
 #define FOR_EACH_1(what, x, ...) what(x)
-#define FOR_EACH_2(what, x, ...)\
-  what(x);\
-  EXPAND(FOR_EACH_1(what,  __VA_ARGS__))
-#define FOR_EACH_3(what, x, ...)\
-  what(x);\
-  EXPAND(FOR_EACH_2(what, __VA_ARGS__))
-#define FOR_EACH_4(what, x, ...)\
-  what(x);\
-  EXPAND(FOR_EACH_3(what,  __VA_ARGS__))
-#define FOR_EACH_5(what, x, ...)\
-  what(x);\
-  EXPAND(FOR_EACH_4(what,  __VA_ARGS__))
-#define FOR_EACH_6(what, x, ...)\
-  what(x);\
-  EXPAND(FOR_EACH_5(what,  __VA_ARGS__))
-#define FOR_EACH_7(what, x, ...)\
-  what(x);\
-  EXPAND(FOR_EACH_6(what,  __VA_ARGS__))
-#define FOR_EACH_8(what, x, ...)\
-  what(x);\
-  EXPAND(FOR_EACH_7(what,  __VA_ARGS__))
+#define FOR_EACH_2(what, x, ...) what(x); EXPAND(FOR_EACH_1(what, __VA_ARGS__))
+#define FOR_EACH_3(what, x, ...) what(x); EXPAND(FOR_EACH_2(what, __VA_ARGS__))
+#define FOR_EACH_4(what, x, ...) what(x); EXPAND(FOR_EACH_3(what, __VA_ARGS__))
+#define FOR_EACH_5(what, x, ...) what(x); EXPAND(FOR_EACH_4(what, __VA_ARGS__))
+#define FOR_EACH_6(what, x, ...) what(x); EXPAND(FOR_EACH_5(what, __VA_ARGS__))
+#define FOR_EACH_7(what, x, ...) what(x); EXPAND(FOR_EACH_6(what, __VA_ARGS__))
+#define FOR_EACH_8(what, x, ...) what(x); EXPAND(FOR_EACH_7(what, __VA_ARGS__))
+#define FOR_EACH_9(what, x, ...) what(x); EXPAND(FOR_EACH_8(what, __VA_ARGS__))
+#define FOR_EACH_10(what, x, ...) what(x); EXPAND(FOR_EACH_9(what, __VA_ARGS__))
+#define FOR_EACH_11(what, x, ...) what(x); EXPAND(FOR_EACH_10(what, __VA_ARGS__))
+#define FOR_EACH_12(what, x, ...) what(x); EXPAND(FOR_EACH_11(what, __VA_ARGS__))
+#define FOR_EACH_13(what, x, ...) what(x); EXPAND(FOR_EACH_12(what, __VA_ARGS__))
+#define FOR_EACH_14(what, x, ...) what(x); EXPAND(FOR_EACH_13(what, __VA_ARGS__))
+#define FOR_EACH_15(what, x, ...) what(x); EXPAND(FOR_EACH_14(what, __VA_ARGS__))
+#define FOR_EACH_16(what, x, ...) what(x); EXPAND(FOR_EACH_15(what, __VA_ARGS__))
+#define FOR_EACH_17(what, x, ...) what(x); EXPAND(FOR_EACH_16(what, __VA_ARGS__))
+#define FOR_EACH_18(what, x, ...) what(x); EXPAND(FOR_EACH_17(what, __VA_ARGS__))
+#define FOR_EACH_19(what, x, ...) what(x); EXPAND(FOR_EACH_18(what, __VA_ARGS__))
+#define FOR_EACH_20(what, x, ...) what(x); EXPAND(FOR_EACH_19(what, __VA_ARGS__))
+#define FOR_EACH_21(what, x, ...) what(x); EXPAND(FOR_EACH_20(what, __VA_ARGS__))
+#define FOR_EACH_22(what, x, ...) what(x); EXPAND(FOR_EACH_21(what, __VA_ARGS__))
+#define FOR_EACH_23(what, x, ...) what(x); EXPAND(FOR_EACH_22(what, __VA_ARGS__))
+#define FOR_EACH_24(what, x, ...) what(x); EXPAND(FOR_EACH_23(what, __VA_ARGS__))
+#define FOR_EACH_25(what, x, ...) what(x); EXPAND(FOR_EACH_24(what, __VA_ARGS__))
+#define FOR_EACH_26(what, x, ...) what(x); EXPAND(FOR_EACH_25(what, __VA_ARGS__))
+#define FOR_EACH_27(what, x, ...) what(x); EXPAND(FOR_EACH_26(what, __VA_ARGS__))
+#define FOR_EACH_28(what, x, ...) what(x); EXPAND(FOR_EACH_27(what, __VA_ARGS__))
+#define FOR_EACH_29(what, x, ...) what(x); EXPAND(FOR_EACH_28(what, __VA_ARGS__))
+#define FOR_EACH_30(what, x, ...) what(x); EXPAND(FOR_EACH_29(what, __VA_ARGS__))
+#define FOR_EACH_31(what, x, ...) what(x); EXPAND(FOR_EACH_30(what, __VA_ARGS__))
+#define FOR_EACH_32(what, x, ...) what(x); EXPAND(FOR_EACH_31(what, __VA_ARGS__))
+#define FOR_EACH_33(what, x, ...) what(x); EXPAND(FOR_EACH_32(what, __VA_ARGS__))
+#define FOR_EACH_34(what, x, ...) what(x); EXPAND(FOR_EACH_33(what, __VA_ARGS__))
+#define FOR_EACH_35(what, x, ...) what(x); EXPAND(FOR_EACH_34(what, __VA_ARGS__))
+#define FOR_EACH_36(what, x, ...) what(x); EXPAND(FOR_EACH_35(what, __VA_ARGS__))
+#define FOR_EACH_37(what, x, ...) what(x); EXPAND(FOR_EACH_36(what, __VA_ARGS__))
+#define FOR_EACH_38(what, x, ...) what(x); EXPAND(FOR_EACH_37(what, __VA_ARGS__))
+#define FOR_EACH_39(what, x, ...) what(x); EXPAND(FOR_EACH_38(what, __VA_ARGS__))
+#define FOR_EACH_40(what, x, ...) what(x); EXPAND(FOR_EACH_39(what, __VA_ARGS__))
+#define FOR_EACH_41(what, x, ...) what(x); EXPAND(FOR_EACH_40(what, __VA_ARGS__))
+#define FOR_EACH_42(what, x, ...) what(x); EXPAND(FOR_EACH_41(what, __VA_ARGS__))
+#define FOR_EACH_43(what, x, ...) what(x); EXPAND(FOR_EACH_42(what, __VA_ARGS__))
+#define FOR_EACH_44(what, x, ...) what(x); EXPAND(FOR_EACH_43(what, __VA_ARGS__))
+#define FOR_EACH_45(what, x, ...) what(x); EXPAND(FOR_EACH_44(what, __VA_ARGS__))
+#define FOR_EACH_46(what, x, ...) what(x); EXPAND(FOR_EACH_45(what, __VA_ARGS__))
+#define FOR_EACH_47(what, x, ...) what(x); EXPAND(FOR_EACH_46(what, __VA_ARGS__))
+#define FOR_EACH_48(what, x, ...) what(x); EXPAND(FOR_EACH_47(what, __VA_ARGS__))
+#define FOR_EACH_49(what, x, ...) what(x); EXPAND(FOR_EACH_48(what, __VA_ARGS__))
+#define FOR_EACH_50(what, x, ...) what(x); EXPAND(FOR_EACH_49(what, __VA_ARGS__))
+#define FOR_EACH_51(what, x, ...) what(x); EXPAND(FOR_EACH_50(what, __VA_ARGS__))
+#define FOR_EACH_52(what, x, ...) what(x); EXPAND(FOR_EACH_51(what, __VA_ARGS__))
+#define FOR_EACH_53(what, x, ...) what(x); EXPAND(FOR_EACH_52(what, __VA_ARGS__))
+#define FOR_EACH_54(what, x, ...) what(x); EXPAND(FOR_EACH_53(what, __VA_ARGS__))
+#define FOR_EACH_55(what, x, ...) what(x); EXPAND(FOR_EACH_54(what, __VA_ARGS__))
+#define FOR_EACH_56(what, x, ...) what(x); EXPAND(FOR_EACH_55(what, __VA_ARGS__))
+#define FOR_EACH_57(what, x, ...) what(x); EXPAND(FOR_EACH_56(what, __VA_ARGS__))
+#define FOR_EACH_58(what, x, ...) what(x); EXPAND(FOR_EACH_57(what, __VA_ARGS__))
+#define FOR_EACH_59(what, x, ...) what(x); EXPAND(FOR_EACH_58(what, __VA_ARGS__))
+#define FOR_EACH_60(what, x, ...) what(x); EXPAND(FOR_EACH_59(what, __VA_ARGS__))
+#define FOR_EACH_61(what, x, ...) what(x); EXPAND(FOR_EACH_60(what, __VA_ARGS__))
+#define FOR_EACH_62(what, x, ...) what(x); EXPAND(FOR_EACH_61(what, __VA_ARGS__))
+#define FOR_EACH_63(what, x, ...) what(x); EXPAND(FOR_EACH_62(what, __VA_ARGS__))
 #define FOR_EACH_NARG(...) FOR_EACH_NARG_(__VA_ARGS__, FOR_EACH_RSEQ_N())
 #define FOR_EACH_NARG_(...) EXPAND(FOR_EACH_ARG_N(__VA_ARGS__))
-#define FOR_EACH_ARG_N(_1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
-#define FOR_EACH_RSEQ_N() 8, 7, 6, 5, 4, 3, 2, 1, 0
+#define FOR_EACH_ARG_N( \
+	_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, \
+	_17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, \
+	_33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, \
+	_49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, \
+	N, ...) N
+#define FOR_EACH_RSEQ_N() \
+	63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, \
+	47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, \
+	31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, \
+	15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
 #define CONCATENATE(x,y) x##y
 #define FOR_EACH_(N, what, ...) EXPAND(CONCATENATE(FOR_EACH_, N)(what, __VA_ARGS__))
 #define FOR_EACH(what, ...) FOR_EACH_(FOR_EACH_NARG(__VA_ARGS__), what, __VA_ARGS__)
 #define STRINGIFY_(X) #X
 #define STRINGIFY(X) STRINGIFY_(X)
 
-#define JSON_INNER_WRITE(X) writer.Key(STRINGIFY(X)); Json::Serializer::ToJson(writer, X);
-#define JSON_INNER_READ(X) \
-member_iterator = document.FindMember(TEXT(STRINGIFY(X))); \
-if (member_iterator == document.MemberEnd()) \
-{ \
-	UE_LOG(LogRapidJson, Error, TEXT("not found member %s"), #X); \
-	return; \
-} \
-Json::Deserializer::FromJson(member_iterator->value, X);
+#define JSON_INNER_VISIT(X) visitor(STRINGIFY(X), &JsonSelfType::X);
 
+// Only the field list is generated per type; reading and writing go through a field table built
+// from it once, with codecs shared by every type (see JsonFieldTable.h).
 #define JSON_DEFINE(...) \
+template <typename VisitorType> \
+void VisitJsonFields(VisitorType&& visitor) const \
+{ \
+	using JsonSelfType = typename TDecay<decltype(*this)>::Type; \
+	FOR_EACH(JSON_INNER_VISIT, __VA_ARGS__) \
+} \
 template <typename WriterType> \
 void ToJson(WriterType& writer) const \
 { \
-	writer.StartObject(); \
-	FOR_EACH(JSON_INNER_WRITE, __VA_ARGS__) \
-	writer.EndObject(); \
+	Json::Detail::WriteFields(writer, *this); \
 } \
 template <typename EncodingType, typename AllocatorType> \
 void FromJson(const rapidjson::GenericValue<EncodingType, AllocatorType>& document) \
 { \
-	rapidjson::GenericValue<EncodingType, AllocatorType>::ConstMemberIterator member_iterator; \
-	FOR_EACH(JSON_INNER_READ, __VA_ARGS__) \
+	Json::Detail::ReadFields(document, *this); \
 } \
 
-#define JSON_EXTERNAL_WRITE(X) writer.Key(STRINGIFY(X)); Json::Serializer::ToJson(writer, data.X);
-#define JSON_EXTERNAL_READ(X) \
-member_iterator = document.FindMember(TEXT(STRINGIFY(X))); \
-if (member_iterator == document.MemberEnd()) \
+#define JSON_EXTERNAL_DEFINE(DataType, ...) \
+template <typename VisitorType> \
+void VisitJsonFields(const DataType& data, VisitorType&& visitor) \
 { \
-	UE_LOG(LogRapidJson, Error, TEXT("not found member %s"), #X); \
-	return; \
+	using JsonSelfType = DataType; \
+	FOR_EACH(JSON_INNER_VISIT, __VA_ARGS__) \
 } \
-Json::Deserializer::FromJson(member_iterator->value, data.X);
-
-#define JSON_EXTERNAL_DEFINE(DataType, ...) \
 template <typename Writer> \
 void ToJson(Writer & writer, const DataType& data) \
 { \
-	writer.StartObject(); \
-	FOR_EACH(JSON_EXTERNAL_WRITE, __VA_ARGS__) \
-	writer.EndObject(); \
+	Json::Detail::WriteFields(writer, data); \
 } \
 template <typename EncodingType, typename AllocatorType> \
 void FromJson(const rapidjson::GenericValue<EncodingType, AllocatorType>& document, DataType& data) \
 { \
-	rapidjson::GenericValue<EncodingType, AllocatorType>::ConstMemberIterator member_iterator; \
-	FOR_EACH(JSON_EXTERNAL_READ, __VA_ARGS__) \
+	Json::Detail::ReadFields(document, data); \
 }
 
 #define JSON_ADD_INT_ENUM(ENUM) \
@@ -120,10 +162,10 @@ BETTER_ENUM(ENUM, Underlying, __VA_ARGS__) \
 template <typename Writer> \
 void ToJson(Writer & writer, const ENUM& o) \
 { \
-	Json::Serializer::ToJson(writer, o._to_string()); \
+	Json::Serializer::Detail::WriteEnumName(writer, o); \
 } \
 template <typename EncodingType, typename AllocatorType> \
 void FromJson(const rapidjson::GenericValue<EncodingType, AllocatorType>& document, ENUM& o) \
 { \
-	o = ENUM::_from_string(TCHAR_TO_UTF8(document.GetString())); \
+	o = Json::Deserializer::Detail::EnumFromString<ENUM>(document); \
 }
@@ -31,5 +31,7 @@ public class RapidJson : ModuleRules
 
         PublicIncludePaths.Add(ThirdPartyPath);
 
+        AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
     }
 }
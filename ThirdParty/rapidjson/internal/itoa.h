@@ -16,6 +16,12 @@
 #define RAPIDJSON_ITOA_
 
 #include "../rapidjson.h"
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_AMD64) && !defined(__INTEL_COMPILER)
+#include <intrin.h>
+#pragma intrinsic(_BitScanForward64)
+#endif
 
 RAPIDJSON_NAMESPACE_BEGIN
 namespace internal {
@@ -302,6 +308,129 @@ inline char* i64toa(int64_t value, char* buffer) {
     return u64toa(u, buffer);
 }
 
+// The *toaPadded() variants below produce the same text as the functions above, but store whole
+// 8-digit groups at once. They may write past the returned end, up to the length of the longest
+// value of their type (10, 11, 20 and 21 characters), so the space must be reserved up front.
+
+#if RAPIDJSON_ENDIAN == RAPIDJSON_LITTLEENDIAN
+
+//! Number of zero bytes at the least significant end of a non-zero value.
+inline int TrailingZeroBytes64(uint64_t x) {
+    RAPIDJSON_ASSERT(x != 0);
+#if defined(_MSC_VER) && defined(_M_AMD64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index) >> 3;
+#elif defined(__GNUC__) && __GNUC__ >= 4
+    return __builtin_ctzll(x) >> 3;
+#else
+    int count = 0;
+    while (!(x & 0xFF)) {
+        x >>= 8;
+        count++;
+    }
+    return count;
+#endif
+}
+
+//! The eight decimal digits of value < 10^8, leading zeros included, as characters in memory order.
+/*! Splits value in halves, quarters and digits within the lanes of a 64-bit word, using multiplications
+    by reciprocals that are exact in that range.
+*/
+inline uint64_t EightDigits(uint32_t value) {
+    RAPIDJSON_ASSERT(value < 100000000);
+    const uint64_t halves = (value / 10000) | (static_cast<uint64_t>(value % 10000) << 32);
+    const uint64_t hundreds = ((halves * 10486) >> 20) & RAPIDJSON_UINT64_C2(0x0000007F, 0x0000007F);
+    const uint64_t pairs = ((halves - 100 * hundreds) << 16) + hundreds;
+    uint64_t digits = ((pairs * 103) >> 10) & RAPIDJSON_UINT64_C2(0x000F000F, 0x000F000F);
+    digits += (pairs - 10 * digits) << 8;
+    return digits + RAPIDJSON_UINT64_C2(0x30303030, 0x30303030);
+}
+
+//! Writes value < 10^8 without leading zeros; always stores 8 bytes.
+inline char* u32toaShortPadded(uint32_t value, char* buffer) {
+    const uint64_t digits = EightDigits(value);
+    // Leading zeros are the low '0' bytes; the last digit is kept even for 0.
+    const int zeros = TrailingZeroBytes64((digits - RAPIDJSON_UINT64_C2(0x30303030, 0x30303030)) | (static_cast<uint64_t>(1) << 56));
+    const uint64_t shifted = digits >> (zeros * 8);
+    std::memcpy(buffer, &shifted, sizeof(shifted));
+    return buffer + 8 - zeros;
+}
+
+inline char* u32toaPadded(uint32_t value, char* buffer) {
+    RAPIDJSON_ASSERT(buffer != 0);
+    if (value < 100000000)
+        return u32toaShortPadded(value, buffer);
+
+    const uint32_t a = value / 100000000; // 1 to 42
+    const uint64_t digits = EightDigits(value - a * 100000000);
+    if (a >= 10) {
+        const char* cDigitsLut = GetDigitsLut();
+        *buffer++ = cDigitsLut[a << 1];
+        *buffer++ = cDigitsLut[(a << 1) + 1];
+    }
+    else
+        *buffer++ = static_cast<char>('0' + static_cast<char>(a));
+    std::memcpy(buffer, &digits, sizeof(digits));
+    return buffer + 8;
+}
+
+inline char* u64toaPadded(uint64_t value, char* buffer) {
+    RAPIDJSON_ASSERT(buffer != 0);
+    const uint64_t kTen8 = 100000000;
+    const uint64_t kTen16 = kTen8 * kTen8;
+
+    if (value < kTen8)
+        return u32toaShortPadded(static_cast<uint32_t>(value), buffer);
+
+    if (value < kTen16)
+        buffer = u32toaShortPadded(static_cast<uint32_t>(value / kTen8), buffer);
+    else {
+        buffer = u32toaShortPadded(static_cast<uint32_t>(value / kTen16), buffer); // 1 to 1844
+        value %= kTen16;
+        const uint64_t digits = EightDigits(static_cast<uint32_t>(value / kTen8));
+        std::memcpy(buffer, &digits, sizeof(digits));
+        buffer += 8;
+    }
+    const uint64_t digits = EightDigits(static_cast<uint32_t>(value % kTen8));
+    std::memcpy(buffer, &digits, sizeof(digits));
+    return buffer + 8;
+}
+
+#else
+
+inline char* u32toaPadded(uint32_t value, char* buffer) {
+    return u32toa(value, buffer);
+}
+
+inline char* u64toaPadded(uint64_t value, char* buffer) {
+    return u64toa(value, buffer);
+}
+
+#endif // RAPIDJSON_ENDIAN
+
+inline char* i32toaPadded(int32_t value, char* buffer) {
+    RAPIDJSON_ASSERT(buffer != 0);
+    uint32_t u = static_cast<uint32_t>(value);
+    if (value < 0) {
+        *buffer++ = '-';
+        u = ~u + 1;
+    }
+
+    return u32toaPadded(u, buffer);
+}
+
+inline char* i64toaPadded(int64_t value, char* buffer) {
+    RAPIDJSON_ASSERT(buffer != 0);
+    uint64_t u = static_cast<uint64_t>(value);
+    if (value < 0) {
+        *buffer++ = '-';
+        u = ~u + 1;
+    }
+
+    return u64toaPadded(u, buffer);
+}
+
 } // namespace internal
 RAPIDJSON_NAMESPACE_END
 
@@ -100,6 +100,25 @@ public:
     bool Uint64(uint64_t u64)   { PrettyPrefix(kNumberType); return Base::EndValue(Base::WriteUint64(u64));  }
     bool Double(double d)       { PrettyPrefix(kNumberType); return Base::EndValue(Base::WriteDouble(d)); }
 
+    //! Writes a whole array of integers, one element at a time to keep the indentation.
+    template <typename T>
+    bool IntegerArray(const T* values, size_t count) {
+        RAPIDJSON_ASSERT(values != 0 || count == 0);
+        StartArray();
+        for (size_t i = 0; i < count; i++) {
+            if (std::numeric_limits<T>::is_signed)
+                Int64(static_cast<int64_t>(values[i]));
+            else
+                Uint64(static_cast<uint64_t>(values[i]));
+        }
+        return EndArray();
+    }
+
+    bool IntArray(const int* values, size_t count)              { return IntegerArray(values, count); }
+    bool UintArray(const unsigned* values, size_t count)        { return IntegerArray(values, count); }
+    bool Int64Array(const int64_t* values, size_t count)        { return IntegerArray(values, count); }
+    bool Uint64Array(const uint64_t* values, size_t count)      { return IntegerArray(values, count); }
+
     bool RawNumber(const Ch* str, SizeType length, bool copy = false) {
         RAPIDJSON_ASSERT(str != 0);
         (void)copy;
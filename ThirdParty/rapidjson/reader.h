@@ -23,6 +23,8 @@
 #include "internal/meta.h"
 #include "internal/stack.h"
 #include "internal/strtod.h"
+#include "internal/itoa.h"
+#include "internal/eisellemire.h"
 #include <limits>
 
 #if defined(RAPIDJSON_SIMD) && defined(_MSC_VER)
@@ -1450,6 +1452,26 @@ private:
         RAPIDJSON_FORCEINLINE Ch Take() { return Base::TakePush(); }
     };
 
+    // Pushes the decimal digits of a significand onto the stack and returns their count.
+    size_t PushSignificandDigits(uint64_t significand) {
+        char* buffer = stack_.template Push<char>(20);
+        const size_t length = static_cast<size_t>(internal::u64toa(significand, buffer) - buffer);
+        stack_.template Pop<char>(20 - length);
+        return length;
+    }
+
+    // Records a digit that no longer fits in the exact significand of ParseNumber().
+    void DropSignificandDigit(uint64_t significand, unsigned digit, bool keep, size_t& keptDigits, size_t& droppedDigits, bool& truncated) {
+        if (digit != 0)
+            truncated = true;
+        if (keep) {
+            if (droppedDigits == 0)
+                keptDigits = PushSignificandDigits(significand);
+            *stack_.template Push<char>() = static_cast<char>('0' + digit);
+            ++droppedDigits;
+        }
+    }
+
     template<unsigned parseFlags, typename InputStream, typename Handler>
     void ParseNumber(InputStream& is, Handler& handler) {
         internal::StreamLocalCopy<InputStream> copy(is);
@@ -1471,7 +1493,6 @@ private:
         unsigned i = 0;
         uint64_t i64 = 0;
         bool use64bit = false;
-        int significandDigit = 0;
         if (RAPIDJSON_UNLIKELY(s.Peek() == '0')) {
             i = 0;
             s.TakePush();
@@ -1489,7 +1510,6 @@ private:
                         }
                     }
                     i = i * 10 + static_cast<unsigned>(s.TakePush() - '0');
-                    significandDigit++;
                 }
             else
                 while (RAPIDJSON_LIKELY(s.Peek() >= '0' && s.Peek() <= '9')) {
@@ -1501,7 +1521,6 @@ private:
                         }
                     }
                     i = i * 10 + static_cast<unsigned>(s.TakePush() - '0');
-                    significandDigit++;
                 }
         }
         // Parse NaN or Infinity here
@@ -1543,7 +1562,6 @@ private:
                             break;
                         }
                     i64 = i64 * 10 + static_cast<unsigned>(s.TakePush() - '0');
-                    significandDigit++;
                 }
             else
                 while (RAPIDJSON_LIKELY(s.Peek() >= '0' && s.Peek() <= '9')) {
@@ -1554,14 +1572,41 @@ private:
                             break;
                         }
                     i64 = i64 * 10 + static_cast<unsigned>(s.TakePush() - '0');
-                    significandDigit++;
                 }
         }
 
+        // Exact significand for Eisel-Lemire. Digits that no longer fit in 64 bits are dropped;
+        // without full precision parsing they are kept on the stack behind the digits of the
+        // significand, in case the rounding turns out to depend on them.
+        const uint64_t kMaxExactSignificand = RAPIDJSON_UINT64_C2(0x19999999, 0x99999998);
+        const bool keepDroppedDigits = !(parseFlags & (kParseFullPrecisionFlag | kParseNumbersAsStringsFlag));
+        bool exactTruncated = false;
+        uint64_t exactSignificand = use64bit ? i64 : i;
+        int expDropped = 0;
+        size_t keptDigits = 0;
+        size_t droppedDigits = 0;
+
+        // The integer part can reach 2^64 - 1, which leaves no room to append digits or round up,
+        // so its last digit is dropped like any other that does not fit, and so are all after it.
+        bool significandFull = exactSignificand > kMaxExactSignificand;
+        if (significandFull) {
+            const unsigned digit = static_cast<unsigned>(exactSignificand % 10);
+            exactSignificand /= 10;
+            DropSignificandDigit(exactSignificand, digit, keepDroppedDigits, keptDigits, droppedDigits, exactTruncated);
+            ++expDropped;
+        }
+
         // Force double for big integer
         if (useDouble) {
             while (RAPIDJSON_LIKELY(s.Peek() >= '0' && s.Peek() <= '9')) {
-                d = d * 10 + (s.TakePush() - '0');
+                const unsigned digit = static_cast<unsigned>(s.TakePush() - '0');
+                if (!significandFull && exactSignificand <= kMaxExactSignificand)
+                    exactSignificand = exactSignificand * 10 + digit;
+                else {
+                    significandFull = true;
+                    DropSignificandDigit(exactSignificand, digit, keepDroppedDigits, keptDigits, droppedDigits, exactTruncated);
+                    ++expDropped;
+                }
             }
         }
 
@@ -1574,40 +1619,16 @@ private:
             if (RAPIDJSON_UNLIKELY(!(s.Peek() >= '0' && s.Peek() <= '9')))
                 RAPIDJSON_PARSE_ERROR(kParseErrorNumberMissFraction, s.Tell());
 
-            if (!useDouble) {
-#if RAPIDJSON_64BIT
-                // Use i64 to store significand in 64-bit architecture
-                if (!use64bit)
-                    i64 = i;
-
-                while (RAPIDJSON_LIKELY(s.Peek() >= '0' && s.Peek() <= '9')) {
-                    if (i64 > RAPIDJSON_UINT64_C2(0x1FFFFF, 0xFFFFFFFF)) // 2^53 - 1 for fast path
-                        break;
-                    else {
-                        i64 = i64 * 10 + static_cast<unsigned>(s.TakePush() - '0');
-                        --expFrac;
-                        if (i64 != 0)
-                            significandDigit++;
-                    }
-                }
-
-                d = static_cast<double>(i64);
-#else
-                // Use double to store significand in 32-bit architecture
-                d = static_cast<double>(use64bit ? i64 : i);
-#endif
-                useDouble = true;
-            }
+            useDouble = true;
 
             while (RAPIDJSON_LIKELY(s.Peek() >= '0' && s.Peek() <= '9')) {
-                if (significandDigit < 17) {
-                    d = d * 10.0 + (s.TakePush() - '0');
+                const unsigned digit = static_cast<unsigned>(s.TakePush() - '0');
+                if (!significandFull && exactSignificand <= kMaxExactSignificand) {
+                    exactSignificand = exactSignificand * 10 + digit;
                     --expFrac;
-                    if (RAPIDJSON_LIKELY(d > 0.0))
-                        significandDigit++;
                 }
                 else
-                    s.TakePush();
+                    DropSignificandDigit(exactSignificand, digit, keepDroppedDigits, keptDigits, droppedDigits, exactTruncated);
             }
         }
         else
@@ -1694,11 +1715,28 @@ private:
            const char* decimal = s.Pop();  // Pop stack no matter if it will be used or not.
 
            if (useDouble) {
-               int p = exp + expFrac;
-               if (parseFlags & kParseFullPrecisionFlag)
+               const int p = exp + expFrac + expDropped;
+               d = static_cast<double>(exactSignificand);
+               double exact = 0.0;
+               double exactUpper = 0.0;
+               size_t digitLength = droppedDigits != 0 ? keptDigits + droppedDigits : 0;
+               const char* digits = digitLength != 0 ? stack_.template Pop<char>(digitLength) : 0;
+               // A truncated significand is only trusted when rounding it up gives the same double.
+               if (internal::EiselLemire(exactSignificand, p, &exact) &&
+                   (!exactTruncated || (exactSignificand != RAPIDJSON_UINT64_C2(0xFFFFFFFF, 0xFFFFFFFF) &&
+                                        internal::EiselLemire(exactSignificand + 1, p, &exactUpper) && exactUpper == exact)))
+                   d = exact;
+               else if (parseFlags & kParseFullPrecisionFlag)
                    d = internal::StrtodFullPrecision(d, p, decimal, length, decimalPosition, exp);
-               else
-                   d = internal::StrtodNormalPrecision(d, p);
+               else {
+                   // Eisel-Lemire could not decide; compare against the decimal digits instead.
+                   if (digitLength == 0) {
+                       digitLength = PushSignificandDigits(exactSignificand);
+                       digits = stack_.template Pop<char>(digitLength);
+                   }
+                   const int digitExp = p - static_cast<int>(droppedDigits);
+                   d = internal::StrtodFullPrecision(d, p, digits, digitLength, digitLength, digitExp);
+               }
 
                // Use > max, instead of == inf, to fix bogus warning -Wfloat-equal
                if (d > (std::numeric_limits<double>::max)()) {
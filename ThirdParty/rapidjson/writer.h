@@ -23,6 +23,7 @@
 #include "internal/itoa.h"
 #include "stringbuffer.h"
 #include <new>      // placement new
+#include <limits>
 
 #if defined(RAPIDJSON_SIMD) && defined(_MSC_VER)
 #include <intrin.h>
@@ -185,6 +186,24 @@ public:
     bool Int64(int64_t i64)     { Prefix(kNumberType); return EndValue(WriteInt64(i64)); }
     bool Uint64(uint64_t u64)   { Prefix(kNumberType); return EndValue(WriteUint64(u64)); }
 
+    //! Writes a whole array of integers.
+    /*! Produces the same text as StartArray(), then Int(), Uint(), Int64() or Uint64() for each
+        element, then EndArray(), but reserves the space for the array once and formats the elements
+        back to back.
+        \tparam T Integer type of at most 64 bits.
+    */
+    template <typename T>
+    bool IntegerArray(const T* values, size_t count) {
+        RAPIDJSON_ASSERT(values != 0 || count == 0);
+        Prefix(kArrayType);
+        return EndValue(WriteIntegerArray(values, count));
+    }
+
+    bool IntArray(const int* values, size_t count)              { return IntegerArray(values, count); }
+    bool UintArray(const unsigned* values, size_t count)        { return IntegerArray(values, count); }
+    bool Int64Array(const int64_t* values, size_t count)        { return IntegerArray(values, count); }
+    bool Uint64Array(const uint64_t* values, size_t count)      { return IntegerArray(values, count); }
+
     //! Writes the given \c double value to the stream
     /*!
         \param d The value to be written.
@@ -373,6 +392,35 @@ protected:
         return true;
     }
 
+    //! Longest text of an element of an integer array, sign included.
+    template <typename T>
+    static size_t MaxIntegerLength() { return sizeof(T) <= 4 ? 11 : 21; }
+
+    //! Formats an integer into space of at least MaxIntegerLength<T>() characters.
+    template <typename T>
+    static char* FormatInteger(T value, char* buffer) {
+        RAPIDJSON_STATIC_ASSERT(sizeof(T) <= 8);
+        if (sizeof(T) <= 4)
+            return std::numeric_limits<T>::is_signed ? internal::i32toaPadded(static_cast<int32_t>(value), buffer) : internal::u32toaPadded(static_cast<uint32_t>(value), buffer);
+        return std::numeric_limits<T>::is_signed ? internal::i64toaPadded(static_cast<int64_t>(value), buffer) : internal::u64toaPadded(static_cast<uint64_t>(value), buffer);
+    }
+
+    template <typename T>
+    bool WriteIntegerArray(const T* values, size_t count) {
+        PutReserve(*os_, 2 + count * (MaxIntegerLength<T>() + 1));
+        PutUnsafe(*os_, '[');
+        for (size_t i = 0; i < count; i++) {
+            if (i != 0)
+                PutUnsafe(*os_, ',');
+            char buffer[24];
+            const char* end = FormatInteger(values[i], buffer);
+            for (const char* p = buffer; p != end; ++p)
+                PutUnsafe(*os_, static_cast<typename OutputStream::Ch>(*p));
+        }
+        PutUnsafe(*os_, ']');
+        return true;
+    }
+
     bool WriteString(const Ch* str, SizeType length)  {
         static const typename OutputStream::Ch hexDigits[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
         static const char escape[256] = {
@@ -458,6 +506,12 @@ protected:
 
     bool WriteRawValue(const Ch* json, size_t length) {
         PutReserve(*os_, length);
+        if (!(writeFlags & kWriteValidateEncodingFlag) && internal::IsSame<SourceEncoding, TargetEncoding>::Value) {
+            // Same encoding on both sides: the raw text is copied verbatim.
+            for (size_t i = 0; i < length; i++)
+                PutUnsafe(*os_, static_cast<typename TargetEncoding::Ch>(json[i]));
+            return true;
+        }
         GenericStringStream<SourceEncoding> is(json);
         while (RAPIDJSON_LIKELY(is.Tell() < length)) {
             RAPIDJSON_ASSERT(is.Peek() != '\0');
@@ -541,6 +595,24 @@ inline bool Writer<StringBuffer>::WriteUint64(uint64_t u) {
     return true;
 }
 
+template<>
+template<typename T>
+inline bool Writer<StringBuffer>::WriteIntegerArray(const T* values, size_t count) {
+    // Elements are formatted in place; the unused part of the reservation is given back at the end.
+    const size_t reserved = 2 + count * (MaxIntegerLength<T>() + 1);
+    char* const begin = os_->Push(reserved);
+    char* cursor = begin;
+    *cursor++ = '[';
+    for (size_t i = 0; i < count; i++) {
+        if (i != 0)
+            *cursor++ = ',';
+        cursor = FormatInteger(values[i], cursor);
+    }
+    *cursor++ = ']';
+    os_->Pop(reserved - static_cast<size_t>(cursor - begin));
+    return true;
+}
+
 template<>
 inline bool Writer<StringBuffer>::WriteDouble(double d) {
     if (internal::Double(d).IsNanOrInf()) {